@@ -26,10 +26,34 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES +=\
         KevDemoMainWindow.cpp \
         KevDemoVLCDecoder.cpp \
+        KevDemoVLCPipeline.cpp \
+        KevDemoFrameQueue.cpp \
+        KevDemoFrameRing.cpp \
+        KevDemoDiffKernel.cpp \
         KevDemoROIBlock.cpp \
+        KevDemoBlobLabeler.cpp \
+        KevDemoMorphology.cpp \
+        KevDemoActivityDetector.cpp \
+        KevDemoLevelTracker.cpp \
+        KevDemoSymbolClock.cpp \
+        KevDemoSymbolTimer.cpp \
+        KevDemoBitStream.cpp \
+        KevDemoVLCFramer.cpp \
+        KevDemoSoftVoter.cpp \
+        KevDemoROITracker.cpp \
+        KevDemoManchesterDecoder.cpp \
+        KevDemoWorkPool.cpp \
+        KevDemoVLCBay.cpp \
+        KevDemoBayManager.cpp \
+        KevDemoROISampler.cpp \
+        KevDemoFrameArena.cpp \
+        KevDemoRSEngine.cpp \
         KevDemoDatabase.cpp \
         KevDemoVBCDecoder.cpp \
         KevDemoCameraPreview.cpp \
+        KevDemoFrameSource.cpp \
+        KevDemoCaptureSource.cpp \
+        KevDemoImageSource.cpp \
         KevDemoVBCReader.cpp \
         KevDemoEVehicle.cpp \
         KevDemoEVCharger.cpp \
@@ -39,10 +63,34 @@ SOURCES +=\
 HEADERS  += KevDemoMainWindow.h \
             KevDemoConfig.h \
             KevDemoVLCDecoder.h \
+            KevDemoVLCPipeline.h \
+            KevDemoFrameQueue.h \
+            KevDemoFrameRing.h \
+            KevDemoDiffKernel.h \
             KevDemoROIBlock.h \
+            KevDemoBlobLabeler.h \
+            KevDemoMorphology.h \
+            KevDemoActivityDetector.h \
+            KevDemoLevelTracker.h \
+            KevDemoSymbolClock.h \
+            KevDemoSymbolTimer.h \
+            KevDemoBitStream.h \
+            KevDemoVLCFramer.h \
+            KevDemoSoftVoter.h \
+            KevDemoROITracker.h \
+            KevDemoManchesterDecoder.h \
+            KevDemoWorkPool.h \
+            KevDemoVLCBay.h \
+            KevDemoBayManager.h \
+            KevDemoROISampler.h \
+            KevDemoFrameArena.h \
+            KevDemoRSEngine.h \
             KevDemoDatabase.h \
             KevDemoVBCDecoder.h \
             KevDemoCameraPreview.h \
+            KevDemoFrameSource.h \
+            KevDemoCaptureSource.h \
+            KevDemoImageSource.h \
             KevDemoVBCReader.h \
             KevDemoEVehicle.h \
             KevDemoEVCharger.h \
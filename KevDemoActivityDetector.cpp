@@ -0,0 +1,148 @@
+#include "KevDemoActivityDetector.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoActivityDetector class
+ * @param nScale downscale factor of the coarse level
+ */
+KevDemoActivityDetector::KevDemoActivityDetector(uint32_t nScale)
+{
+    setScale(nScale);
+}
+
+/**
+ * @brief This is a destructor of KevDemoActivityDetector class
+ */
+KevDemoActivityDetector::~KevDemoActivityDetector()
+{
+    m_rPrevLevel.release();
+    m_rCurrLevel.release();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function detects changes of the current frame from the previous frame
+ *        on the coarse level. The previous frame is reduced only if its coarse level
+ *        is not kept from the last detection.
+ * @param rPrevFrame a previous frame (CV_8UC1)
+ * @param rCurrFrame a current frame (CV_8UC1)
+ * @param nThreshold threshold of the difference of full resolution pixels
+ * @param rRegion the region of the frame covering all the changes
+ * @return true if any change is detected, or if coarse detection is not applicable
+ *         and rRegion is the whole frame, otherwise false
+ */
+bool
+KevDemoActivityDetector::detect(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame,
+                                uint32_t nThreshold, cv::Rect& rRegion)
+{
+    int scale = m_nScale;
+
+    rRegion = cv::Rect(0, 0, rCurrFrame.cols, rCurrFrame.rows);
+    m_nNumActivePixels = 0;
+
+    // escalate to the whole frame if the frames are too small to be reduced
+    if(scale <= 1 || rCurrFrame.cols < scale || rCurrFrame.rows < scale ||
+       rPrevFrame.size() != rCurrFrame.size())
+    {
+        reset();
+        return true;
+    }
+
+    if(m_bIsPrevLevelValid == false || m_rPrevLevel.cols != rCurrFrame.cols / scale ||
+       m_rPrevLevel.rows != rCurrFrame.rows / scale)
+    {
+        buildLevel(rPrevFrame, m_rPrevLevel);
+    }
+
+    buildLevel(rCurrFrame, m_rCurrLevel);
+
+    // bounding box of the changed coarse pixels
+    int threshold = (int)(nThreshold * KEV_ACTIVITY_THRESHOLD_RATIO);
+    int cols = m_rCurrLevel.cols;
+    int rows = m_rCurrLevel.rows;
+    int x0 = cols, y0 = rows, x1 = -1, y1 = -1;
+
+    for(int y = 0; y < rows; y++)
+    {
+        const uint8_t *prev = m_rPrevLevel.ptr<uint8_t>(y);
+        const uint8_t *curr = m_rCurrLevel.ptr<uint8_t>(y);
+
+        for(int x = 0; x < cols; x++)
+        {
+            if(std::abs(curr[x] - prev[x]) > threshold)
+            {
+                x0 = std::min(x0, x);
+                x1 = std::max(x1, x);
+                y0 = std::min(y0, y);
+                y1 = y;
+                m_nNumActivePixels++;
+            }
+        }
+    }
+
+    // keep the coarse level of the current frame for the next detection
+    cv::swap(m_rPrevLevel, m_rCurrLevel);
+    m_bIsPrevLevelValid = true;
+
+    if(m_nNumActivePixels == 0)
+    {
+        rRegion = cv::Rect();
+        return false;
+    }
+
+    // the pixels left over by the reduction belong to the last coarse column and row
+    int left   = std::max(x0 - KEV_ACTIVITY_MARGIN, 0) * scale;
+    int top    = std::max(y0 - KEV_ACTIVITY_MARGIN, 0) * scale;
+    int right  = (x1 + KEV_ACTIVITY_MARGIN + 1 >= cols) ? rCurrFrame.cols : (x1 + KEV_ACTIVITY_MARGIN + 1) * scale;
+    int bottom = (y1 + KEV_ACTIVITY_MARGIN + 1 >= rows) ? rCurrFrame.rows : (y1 + KEV_ACTIVITY_MARGIN + 1) * scale;
+
+    rRegion = cv::Rect(left, top, right - left, bottom - top);
+
+    return true;
+}
+
+/**
+ * @brief This function discards the coarse level of the previous frame, so that
+ *        the next detection reduces its previous frame again.
+ */
+void
+KevDemoActivityDetector::reset()
+{
+    m_bIsPrevLevelValid = false;
+    m_nNumActivePixels = 0;
+}
+
+/**
+ * @brief This function sets the downscale factor of the coarse level.
+ * @param nScale downscale factor (1 disables coarse detection)
+ */
+void
+KevDemoActivityDetector::setScale(uint32_t nScale)
+{
+    m_nScale = std::max<uint32_t>(nScale, 1);
+    reset();
+}
+
+/**
+ * @brief This function reduces a frame into a coarse level by averaging each
+ *        (scale x scale) block of pixels.
+ * @param rFrame a frame (CV_8UC1)
+ * @param rLevel a coarse level, reallocated only when the frame size changes
+ */
+void
+KevDemoActivityDetector::buildLevel(const cv::Mat& rFrame, cv::Mat& rLevel)
+{
+    cv::Size size(rFrame.cols / m_nScale, rFrame.rows / m_nScale);
+
+    // an integer downscale factor takes the box-filtering path of INTER_AREA
+    cv::Mat frame = rFrame(cv::Rect(0, 0, size.width * m_nScale, size.height * m_nScale));
+    cv::resize(frame, rLevel, size, 0, 0, cv::INTER_AREA);
+}
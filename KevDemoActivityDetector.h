@@ -0,0 +1,64 @@
+#ifndef _KEV_DEMO_ACTIVITY_DETECTOR_H_
+#define _KEV_DEMO_ACTIVITY_DETECTOR_H_
+
+#include "KevDemoConfig.h"
+
+// default downscale factor of the coarse level (1 disables coarse detection)
+#define KEV_ACTIVITY_DEFAULT_SCALE      4
+
+// a coarse pixel averages partially covered LEDs, so its threshold is lowered
+#define KEV_ACTIVITY_THRESHOLD_RATIO    0.5f
+
+// margin around the active coarse pixels in coarse pixels
+#define KEV_ACTIVITY_MARGIN             2
+
+/**
+ * @brief a class for detecting changes between frames on a coarse level
+ *
+ * Frames are box-filtered down to a coarse level of 1/scale of the frame size,
+ * and the coarse levels of consecutive frames are compared against a threshold.
+ * The coarse level of the previous frame is kept, so that each frame is reduced
+ * only once. If any coarse pixel changes, the bounding region of the changes is
+ * returned in the frame coordinates, so that a full resolution detection can be
+ * restricted to it.
+ */
+class KevDemoActivityDetector
+{
+private:
+
+    // downscale factor of the coarse level
+    uint32_t m_nScale;
+
+    // coarse levels of the previous and current frames
+    cv::Mat m_rPrevLevel;
+    cv::Mat m_rCurrLevel;
+
+    // whether the coarse level of the previous frame is valid
+    bool m_bIsPrevLevelValid;
+
+    // number of changed coarse pixels of the last detection
+    uint32_t m_nNumActivePixels;
+
+public:
+
+    explicit KevDemoActivityDetector(uint32_t nScale = KEV_ACTIVITY_DEFAULT_SCALE);
+    virtual ~KevDemoActivityDetector();
+
+    // detect changes of the current frame from the previous frame
+    bool detect(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame,
+                uint32_t nThreshold, cv::Rect& rRegion);
+
+    void reset();
+
+    // accessor & mutator
+    void setScale(uint32_t nScale);
+    inline uint32_t getScale()              { return m_nScale;           }
+    inline uint32_t getNumActivePixels()    { return m_nNumActivePixels; }
+
+private:
+
+    // reduce a frame into a coarse level
+    void buildLevel(const cv::Mat& rFrame, cv::Mat& rLevel);
+};
+
+#endif // _KEV_DEMO_ACTIVITY_DETECTOR_H_
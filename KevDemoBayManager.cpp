@@ -0,0 +1,178 @@
+#include "KevDemoBayManager.h"
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoBayManager class
+ * @param nNumWorkers the number of decoding workers shared by the bays
+ */
+KevDemoBayManager::KevDemoBayManager(uint32_t nNumWorkers) :
+    m_rPool(nNumWorkers)
+{
+    m_bIsOpened = false;
+}
+
+/**
+ * @brief This is a destructor of KevDemoBayManager class
+ */
+KevDemoBayManager::~KevDemoBayManager()
+{
+    removeBays();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function adds a bay with its own decoder.
+ * @param nDecodeType VLC decoder type (KEV_VLC_DEC_MI or KEV_VLC_DEC_RS)
+ * @return index of the bay
+ */
+uint32_t
+KevDemoBayManager::addBay(int nDecodeType)
+{
+    uint32_t index = (uint32_t)m_rBays.size();
+
+    m_rBays.push_back(new KevDemoVLCBay(index, nDecodeType, &m_rPool));
+    m_rCameras.push_back(nullptr);
+
+    return index;
+}
+
+/**
+ * @brief This function closes and removes all the bays.
+ */
+void
+KevDemoBayManager::removeBays()
+{
+    close();
+
+    for(uint32_t i = 0; i < m_rBays.size(); i++)
+    {
+        delete m_rCameras[i];
+        delete m_rBays[i];
+    }
+
+    m_rBays.clear();
+    m_rCameras.clear();
+}
+
+/**
+ * @brief This function starts the workers and opens all the bays.
+ * @return error information
+ */
+KevDemoError_t
+KevDemoBayManager::open()
+{
+    if(m_bIsOpened == true)
+    {
+        return KEV_SUCCESS;
+    }
+
+    KevDemoError_t error = m_rPool.open();
+
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
+
+    for(KevDemoVLCBay *bay : m_rBays)
+    {
+        bay->open();
+    }
+
+    m_bIsOpened = true;
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function stops the cameras, the bays and then the workers.
+ */
+void
+KevDemoBayManager::close()
+{
+    for(KevDemoCameraPreview *camera : m_rCameras)
+    {
+        if(camera != nullptr)
+        {
+            camera->close();
+        }
+    }
+
+    for(KevDemoVLCBay *bay : m_rBays)
+    {
+        bay->close();
+    }
+
+    // the bays queued in the pool are dropped after the running ones return
+    m_rPool.close();
+
+    m_bIsOpened = false;
+}
+
+/**
+ * @brief This function opens a camera to capture the frames of a bay on its own thread.
+ * @param nIndex bay index
+ * @param nDevice camera device ID
+ * @param rCaptureSize capture resolution (an empty size for the camera default)
+ * @return error information
+ */
+KevDemoError_t
+KevDemoBayManager::openCamera(uint32_t nIndex, int nDevice, cv::Size rCaptureSize)
+{
+    if(nIndex >= m_rBays.size())
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    if(m_rCameras[nIndex] == nullptr)
+    {
+        m_rCameras[nIndex] = new KevDemoCameraPreview();
+
+        // frames are pushed on the capture thread
+        QObject::connect(m_rCameras[nIndex], SIGNAL(sig_receiveFrame(KevDemoFrame_t)),
+                         m_rBays[nIndex], SLOT(slot_pushFrame(KevDemoFrame_t)), Qt::DirectConnection);
+    }
+
+    if(m_rCameras[nIndex]->open(nDevice, rCaptureSize) == false)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function pushes a frame of a bay without a camera.
+ * @param nIndex bay index
+ * @param rFrame a timestamped frame
+ */
+void
+KevDemoBayManager::pushFrame(uint32_t nIndex, const KevDemoFrame_t& rFrame)
+{
+    if(nIndex < m_rBays.size())
+    {
+        m_rBays[nIndex]->pushFrame(rFrame);
+    }
+}
+
+/**
+ * @brief This function takes the batch of bits and frame ends decoded by a bay.
+ * @param nIndex bay index
+ * @param rDecodedStream decoded bits
+ * @return true if any bit or frame end is decoded, otherwise false
+ */
+bool
+KevDemoBayManager::takeDecodedBits(uint32_t nIndex, KevDemoBitStream& rDecodedStream)
+{
+    if(nIndex >= m_rBays.size())
+    {
+        return false;
+    }
+
+    return m_rBays[nIndex]->takeDecodedBits(rDecodedStream);
+}
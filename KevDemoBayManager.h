@@ -0,0 +1,59 @@
+#ifndef _KEV_DEMO_BAY_MANAGER_H_
+#define _KEV_DEMO_BAY_MANAGER_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoVLCBay.h"
+#include "KevDemoWorkPool.h"
+#include "KevDemoCameraPreview.h"
+
+/**
+ * @brief a class for decoding the cameras of many charging bays in a single process
+ *
+ * Every bay has its own camera, capture thread and decoder, while the frames of all
+ * the bays are decoded on a single pool of a fixed number of workers, e.g. one per
+ * core, instead of a decode thread per bay. Bays are added and configured while the
+ * manager is closed.
+ */
+class KevDemoBayManager
+{
+private:
+
+    // work pool shared by the bays
+    KevDemoWorkPool m_rPool;
+
+    // bays and their cameras (nullptr for a bay fed by pushFrame())
+    std::vector<KevDemoVLCBay *> m_rBays;
+    std::vector<KevDemoCameraPreview *> m_rCameras;
+
+    // manager flag
+    bool m_bIsOpened;
+
+public:
+
+    explicit KevDemoBayManager(uint32_t nNumWorkers);
+    virtual ~KevDemoBayManager();
+
+    // bays
+    uint32_t addBay(int nDecodeType);
+    void removeBays();
+
+    // open & close all the bays
+    KevDemoError_t open();
+    void close();
+
+    // capture a bay from a camera, or push its frames directly
+    KevDemoError_t openCamera(uint32_t nIndex, int nDevice, cv::Size rCaptureSize = cv::Size());
+    void pushFrame(uint32_t nIndex, const KevDemoFrame_t& rFrame);
+
+    // take the decoded bits of a bay
+    bool takeDecodedBits(uint32_t nIndex, KevDemoBitStream& rDecodedStream);
+
+    // accessor
+    inline uint32_t getNumBays()                    { return (uint32_t)m_rBays.size(); }
+    inline uint32_t getNumWorkers()                 { return m_rPool.getNumWorkers();  }
+    inline KevDemoVLCBay *getBay(uint32_t nIndex)   { return m_rBays[nIndex];          }
+    inline KevDemoWorkStats_t getWorkStats()        { return m_rPool.getStats();       }
+    inline bool isOpened()                          { return m_bIsOpened;              }
+};
+
+#endif // _KEV_DEMO_BAY_MANAGER_H_
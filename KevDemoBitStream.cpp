@@ -0,0 +1,298 @@
+#include "KevDemoBitStream.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoBitStream class
+ */
+KevDemoBitStream::KevDemoBitStream()
+{
+    m_nNumBits = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoBitStream class
+ */
+KevDemoBitStream::~KevDemoBitStream()
+{
+    clear();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function appends a bit.
+ * @param nBit a bit (only its least significant bit is used)
+ * @param nConfidence confidence of the bit
+ */
+void
+KevDemoBitStream::append(int nBit, uint8_t nConfidence)
+{
+    uint32_t offset = m_nNumBits % KEV_BIT_STREAM_WORD_BITS;
+
+    if(offset == 0)
+    {
+        m_rWords.push_back(0);
+    }
+
+    m_rWords.back() |= (uint64_t)(nBit & 1) << (KEV_BIT_STREAM_WORD_BITS - 1 - offset);
+    m_rConfidences.push_back(nConfidence);
+    m_nNumBits++;
+}
+
+/**
+ * @brief This function appends the bits of a value, from its most significant bit.
+ * @param nBits a value whose least significant nLength bits are appended
+ * @param nLength the number of bits (up to 64)
+ * @param nConfidence confidence of all the bits
+ */
+void
+KevDemoBitStream::appendBits(uint64_t nBits, uint32_t nLength, uint8_t nConfidence)
+{
+    packBits(nBits, nLength);
+    m_rConfidences.insert(m_rConfidences.end(), nLength, nConfidence);
+}
+
+/**
+ * @brief This function appends the bits and the frames of another stream. A frame
+ *        left open at the end of this stream continues with the bits of the other.
+ * @param rStream a stream to be appended
+ */
+void
+KevDemoBitStream::append(const KevDemoBitStream& rStream)
+{
+    uint32_t numBits = m_nNumBits;
+
+    appendRange(rStream, 0, rStream.m_nNumBits);
+
+    for(uint32_t frameEnd : rStream.m_rFrameEnds)
+    {
+        m_rFrameEnds.push_back(numBits + frameEnd);
+    }
+}
+
+/**
+ * @brief This function ends a frame at the current bit.
+ */
+void
+KevDemoBitStream::endFrame()
+{
+    m_rFrameEnds.push_back(m_nNumBits);
+}
+
+/**
+ * @brief This function reads bits as a value, whose most significant bit is the first bit.
+ * @param nOffset offset of the first bit
+ * @param nLength the number of bits (up to 64, within the stream)
+ * @return the value of the bits
+ */
+uint64_t
+KevDemoBitStream::readBits(uint32_t nOffset, uint32_t nLength) const
+{
+    if(nLength == 0)
+    {
+        return 0;
+    }
+
+    uint32_t index = nOffset / KEV_BIT_STREAM_WORD_BITS;
+    uint32_t shift = nOffset % KEV_BIT_STREAM_WORD_BITS;
+
+    uint64_t value = m_rWords[index] << shift;
+
+    if(shift != 0 && shift + nLength > KEV_BIT_STREAM_WORD_BITS)
+    {
+        value |= m_rWords[index + 1] >> (KEV_BIT_STREAM_WORD_BITS - shift);
+    }
+
+    return (nLength == KEV_BIT_STREAM_WORD_BITS) ? value : value >> (KEV_BIT_STREAM_WORD_BITS - nLength);
+}
+
+/**
+ * @brief This function moves the bits of the first frame out of the stream.
+ * @param rFrame the bits of the first frame, without a frame end
+ * @return true if a frame is popped, otherwise false
+ */
+bool
+KevDemoBitStream::popFrame(KevDemoBitStream& rFrame)
+{
+    rFrame.clear();
+
+    if(m_rFrameEnds.empty() == true)
+    {
+        return false;
+    }
+
+    uint32_t length = m_rFrameEnds.front();
+
+    rFrame.appendRange(*this, 0, length);
+
+    m_rFrameEnds.erase(m_rFrameEnds.begin());
+    removeLeading(length);
+
+    return true;
+}
+
+/**
+ * @brief This function moves the given number of leading bits out of the stream
+ *        regardless of frame ends. The frame ends before the last moved bit are dropped.
+ * @param nLength the number of bits
+ * @param rBits the moved bits, without a frame end
+ * @return true if the bits are popped, otherwise false if no bit is requested or the
+ *         stream is shorter
+ */
+bool
+KevDemoBitStream::popBits(uint32_t nLength, KevDemoBitStream& rBits)
+{
+    rBits.clear();
+
+    if(nLength == 0 || nLength > m_nNumBits)
+    {
+        return false;
+    }
+
+    rBits.appendRange(*this, 0, nLength);
+    removeLeading(nLength);
+
+    return true;
+}
+
+/**
+ * @brief This function removes the given number of leading bits and the frame ends
+ *        before the last removed bit, and shifts the remaining bits and frame ends
+ *        to the front.
+ * @param nLength the number of bits
+ */
+void
+KevDemoBitStream::removeLeading(uint32_t nLength)
+{
+    uint32_t remaining = m_nNumBits - nLength;
+
+    // shift the remaining bits to the front in place; a word is read before it is written
+    for(uint32_t offset = 0; offset < remaining; offset += KEV_BIT_STREAM_WORD_BITS)
+    {
+        uint32_t numBits = std::min<uint32_t>(remaining - offset, KEV_BIT_STREAM_WORD_BITS);
+        uint64_t bits = readBits(nLength + offset, numBits);
+
+        m_rWords[offset / KEV_BIT_STREAM_WORD_BITS] =
+            (numBits == KEV_BIT_STREAM_WORD_BITS) ? bits : bits << (KEV_BIT_STREAM_WORD_BITS - numBits);
+    }
+
+    m_rWords.resize((remaining + KEV_BIT_STREAM_WORD_BITS - 1) / KEV_BIT_STREAM_WORD_BITS);
+    m_rConfidences.erase(m_rConfidences.begin(), m_rConfidences.begin() + nLength);
+    m_nNumBits = remaining;
+
+    // the frame ends within the removed bits are dropped
+    size_t numEnds = 0;
+
+    while(numEnds < m_rFrameEnds.size() && m_rFrameEnds[numEnds] < nLength)
+    {
+        numEnds++;
+    }
+
+    m_rFrameEnds.erase(m_rFrameEnds.begin(), m_rFrameEnds.begin() + numEnds);
+
+    for(uint32_t& frameEnd : m_rFrameEnds)
+    {
+        frameEnd -= nLength;
+    }
+}
+
+/**
+ * @brief This function appends all the bits of the stream to a list of bits.
+ * @param rBits a list of bits
+ */
+void
+KevDemoBitStream::unpack(std::vector<int>& rBits) const
+{
+    rBits.reserve(rBits.size() + m_nNumBits);
+
+    for(uint32_t i = 0; i < m_nNumBits; i++)
+    {
+        rBits.push_back(getBit(i));
+    }
+}
+
+/**
+ * @brief This function removes all the bits and frames, keeping the allocated words.
+ */
+void
+KevDemoBitStream::clear()
+{
+    m_rWords.clear();
+    m_rConfidences.clear();
+    m_rFrameEnds.clear();
+    m_nNumBits = 0;
+}
+
+/**
+ * @brief This function swaps the contents of two streams.
+ * @param rStream another stream
+ */
+void
+KevDemoBitStream::swap(KevDemoBitStream& rStream)
+{
+    m_rWords.swap(rStream.m_rWords);
+    m_rConfidences.swap(rStream.m_rConfidences);
+    m_rFrameEnds.swap(rStream.m_rFrameEnds);
+    std::swap(m_nNumBits, rStream.m_nNumBits);
+}
+
+/**
+ * @brief This function packs the bits of a value into the words.
+ * @param nBits a value whose least significant nLength bits are packed
+ * @param nLength the number of bits (up to 64)
+ */
+void
+KevDemoBitStream::packBits(uint64_t nBits, uint32_t nLength)
+{
+    if(nLength == 0)
+    {
+        return;
+    }
+
+    uint32_t offset = m_nNumBits % KEV_BIT_STREAM_WORD_BITS;
+
+    // align the bits to the most significant bit
+    uint64_t bits = (nLength == KEV_BIT_STREAM_WORD_BITS) ? nBits : nBits << (KEV_BIT_STREAM_WORD_BITS - nLength);
+
+    if(offset == 0)
+    {
+        m_rWords.push_back(bits);
+    }
+    else
+    {
+        m_rWords.back() |= bits >> offset;
+
+        if(offset + nLength > KEV_BIT_STREAM_WORD_BITS)
+        {
+            m_rWords.push_back(bits << (KEV_BIT_STREAM_WORD_BITS - offset));
+        }
+    }
+
+    m_nNumBits += nLength;
+}
+
+/**
+ * @brief This function appends a range of bits of another stream with their confidences.
+ * @param rStream another stream
+ * @param nOffset offset of the first bit
+ * @param nLength the number of bits
+ */
+void
+KevDemoBitStream::appendRange(const KevDemoBitStream& rStream, uint32_t nOffset, uint32_t nLength)
+{
+    for(uint32_t offset = 0; offset < nLength; offset += KEV_BIT_STREAM_WORD_BITS)
+    {
+        uint32_t numBits = std::min<uint32_t>(nLength - offset, KEV_BIT_STREAM_WORD_BITS);
+        packBits(rStream.readBits(nOffset + offset, numBits), numBits);
+    }
+
+    m_rConfidences.insert(m_rConfidences.end(), rStream.m_rConfidences.begin() + nOffset,
+                          rStream.m_rConfidences.begin() + nOffset + nLength);
+}
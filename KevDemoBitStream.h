@@ -0,0 +1,92 @@
+#ifndef _KEV_DEMO_BIT_STREAM_H_
+#define _KEV_DEMO_BIT_STREAM_H_
+
+#include "KevDemoConfig.h"
+
+// number of bits packed in a word
+#define KEV_BIT_STREAM_WORD_BITS        64
+
+// confidence of a bit decided without any doubt
+#define KEV_BIT_STREAM_MAX_CONFIDENCE   255
+
+/**
+ * @brief a class for streaming decoded bits packed in 64-bit words
+ *
+ * Bits are packed from the most significant bit of each word, so the first bits
+ * of a stream read as the leading bits of a value. Each bit has a confidence
+ * byte (0 for a guess, 255 for certain), and the producer ends a frame, e.g. a
+ * data burst, at the current bit, so a consumer pops whole frames of any length.
+ * A frame may be empty if nothing was decoded before its end.
+ */
+class KevDemoBitStream
+{
+private:
+
+    // packed bits and their confidences
+    std::vector<uint64_t> m_rWords;
+    std::vector<uint8_t> m_rConfidences;
+    uint32_t m_nNumBits;
+
+    // bit offsets of the ends of frames
+    std::vector<uint32_t> m_rFrameEnds;
+
+public:
+
+    KevDemoBitStream();
+    virtual ~KevDemoBitStream();
+
+    // producer procedures
+    void append(int nBit, uint8_t nConfidence = KEV_BIT_STREAM_MAX_CONFIDENCE);
+    void appendBits(uint64_t nBits, uint32_t nLength, uint8_t nConfidence = KEV_BIT_STREAM_MAX_CONFIDENCE);
+    void append(const KevDemoBitStream& rStream);
+    void endFrame();
+
+    // consumer procedures
+    uint64_t readBits(uint32_t nOffset, uint32_t nLength) const;
+    bool popFrame(KevDemoBitStream& rFrame);
+    bool popBits(uint32_t nLength, KevDemoBitStream& rBits);
+    void unpack(std::vector<int>& rBits) const;
+
+    void clear();
+    void swap(KevDemoBitStream& rStream);
+
+    // accessor
+    inline uint32_t getNumBits() const                          { return m_nNumBits;            }
+    inline uint32_t getNumFrames() const                        { return m_rFrameEnds.size();   }
+    inline bool isEmpty() const                                 { return m_nNumBits == 0 && m_rFrameEnds.empty(); }
+    inline const std::vector<uint64_t>& getWords() const        { return m_rWords;              }
+    inline const std::vector<uint8_t>& getConfidences() const   { return m_rConfidences;        }
+
+    /**
+     * @brief This function returns a bit of the stream.
+     * @param nIndex bit index
+     * @return the bit (0 or 1)
+     */
+    inline int getBit(uint32_t nIndex) const
+    {
+        return (m_rWords[nIndex / KEV_BIT_STREAM_WORD_BITS] >> (KEV_BIT_STREAM_WORD_BITS - 1 - nIndex % KEV_BIT_STREAM_WORD_BITS)) & 1;
+    }
+
+    /**
+     * @brief This function returns the confidence of a bit of the stream.
+     * @param nIndex bit index
+     * @return the confidence (0 to 255)
+     */
+    inline uint8_t getConfidence(uint32_t nIndex) const
+    {
+        return m_rConfidences[nIndex];
+    }
+
+private:
+
+    // pack bits without their confidences
+    void packBits(uint64_t nBits, uint32_t nLength);
+
+    // append a range of bits of another stream
+    void appendRange(const KevDemoBitStream& rStream, uint32_t nOffset, uint32_t nLength);
+
+    // remove leading bits and their frame ends
+    void removeLeading(uint32_t nLength);
+};
+
+#endif // _KEV_DEMO_BIT_STREAM_H_
@@ -0,0 +1,246 @@
+#include "KevDemoBlobLabeler.h"
+
+#include <cstring>
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoBlobLabeler class
+ */
+KevDemoBlobLabeler::KevDemoBlobLabeler()
+{
+}
+
+/**
+ * @brief This is a destructor of KevDemoBlobLabeler class
+ */
+KevDemoBlobLabeler::~KevDemoBlobLabeler()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function labels the 8-connected components of a binary mask, and
+ *        gathers their bounding boxes and areas.
+ * @param rMask a binary mask (CV_8UC1), where non-zero pixels are foreground
+ * @return error information
+ */
+KevDemoError_t
+KevDemoBlobLabeler::label(const cv::Mat& rMask)
+{
+    if(rMask.empty() == true || rMask.type() != CV_8UC1)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    m_rRuns.clear();
+    m_rParents.clear();
+    m_rComponents.clear();
+
+    uint32_t prevStart = 0;
+    uint32_t prevEnd = 0;
+
+    for(int y = 0; y < rMask.rows; y++)
+    {
+        uint32_t currStart = m_rRuns.size();
+        extractRuns(rMask.ptr<uint8_t>(y), rMask.cols, y);
+        uint32_t currEnd = m_rRuns.size();
+
+        for(uint32_t i = currStart; i < currEnd; i++)
+        {
+            m_rParents.push_back(i);
+        }
+
+        // merge the runs touching each other including diagonally
+        uint32_t p = prevStart;
+        uint32_t c = currStart;
+
+        while(p < prevEnd && c < currEnd)
+        {
+            BlobRun_t &prevRun = m_rRuns[p];
+            BlobRun_t &currRun = m_rRuns[c];
+
+            if(prevRun.x0 <= currRun.x1 + 1 && currRun.x0 <= prevRun.x1 + 1)
+            {
+                unite(p, c);
+            }
+
+            // advance the run which ends first
+            if(prevRun.x1 < currRun.x1)
+            {
+                p++;
+            }
+            else
+            {
+                c++;
+            }
+        }
+
+        prevStart = currStart;
+        prevEnd = currEnd;
+    }
+
+    // gather the statistics of each component at its root run
+    m_rComponentIndices.assign(m_rRuns.size(), -1);
+
+    for(uint32_t i = 0; i < m_rRuns.size(); i++)
+    {
+        BlobRun_t &run = m_rRuns[i];
+        uint32_t root = findRoot(i);
+        int &index = m_rComponentIndices[root];
+
+        if(index < 0)
+        {
+            index = m_rComponents.size();
+            m_rComponents.push_back({cv::Rect(run.x0, run.y, run.x1 - run.x0 + 1, 1), 0});
+        }
+
+        BlobStats_t &stats = m_rComponents[index];
+
+        int x0 = std::min(stats.boundingRect.x, run.x0);
+        int x1 = std::max(stats.boundingRect.x + stats.boundingRect.width - 1, run.x1);
+
+        stats.boundingRect.x = x0;
+        stats.boundingRect.width = x1 - x0 + 1;
+        stats.boundingRect.height = run.y - stats.boundingRect.y + 1;
+        stats.area += run.x1 - run.x0 + 1;
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function builds the convex hulls of the selected components from the
+ *        end points of their runs in a single pass over the runs. The lists of points
+ *        and hulls are never shrunk, so their buffers are reused by the next frames.
+ * @param rSelected indices of the selected components
+ * @param rHulls convex hulls of the selected components in the order of rSelected,
+ *        in its first rSelected.size() entries
+ */
+void
+KevDemoBlobLabeler::buildHulls(const std::vector<uint32_t>& rSelected,
+                               std::vector<std::vector<cv::Point> >& rHulls)
+{
+    m_rHullSlots.assign(m_rComponents.size(), -1);
+
+    for(uint32_t i = 0; i < rSelected.size(); i++)
+    {
+        m_rHullSlots[rSelected[i]] = i;
+    }
+
+    // the hull of a component is the hull of the end points of its runs
+    std::vector<std::vector<cv::Point> > &points = m_rHullPoints;
+
+    if(points.size() < rSelected.size())
+    {
+        points.resize(rSelected.size());
+    }
+
+    for(uint32_t i = 0; i < rSelected.size(); i++)
+    {
+        points[i].clear();
+    }
+
+    for(uint32_t i = 0; i < m_rRuns.size(); i++)
+    {
+        int slot = m_rHullSlots[m_rComponentIndices[findRoot(i)]];
+
+        if(slot < 0)
+        {
+            continue;
+        }
+
+        BlobRun_t &run = m_rRuns[i];
+        points[slot].push_back(cv::Point(run.x0, run.y));
+
+        if(run.x1 != run.x0)
+        {
+            points[slot].push_back(cv::Point(run.x1, run.y));
+        }
+    }
+
+    if(rHulls.size() < rSelected.size())
+    {
+        rHulls.resize(rSelected.size());
+    }
+
+    for(uint32_t i = 0; i < rSelected.size(); i++)
+    {
+        cv::convexHull(points[i], rHulls[i]);
+    }
+}
+
+/**
+ * @brief This function merges the components of two runs.
+ * @param nRun1 a run
+ * @param nRun2 another run
+ */
+void
+KevDemoBlobLabeler::unite(uint32_t nRun1, uint32_t nRun2)
+{
+    uint32_t root1 = findRoot(nRun1);
+    uint32_t root2 = findRoot(nRun2);
+
+    // the earlier run becomes the root to keep components in raster order
+    if(root1 < root2)
+    {
+        m_rParents[root2] = root1;
+    }
+    else if(root2 < root1)
+    {
+        m_rParents[root1] = root2;
+    }
+}
+
+/**
+ * @brief This function appends the runs of non-zero pixels of a row. Zero pixels
+ *        are skipped eight at a time.
+ * @param pRow a row of the mask
+ * @param nWidth row width
+ * @param nRow row index
+ */
+void
+KevDemoBlobLabeler::extractRuns(const uint8_t *pRow, int nWidth, int nRow)
+{
+    int x = 0;
+
+    while(x < nWidth)
+    {
+        // skip zero pixels
+        for(uint64_t word; x + 8 <= nWidth; x += 8)
+        {
+            memcpy(&word, pRow + x, sizeof(word));
+
+            if(word != 0)
+            {
+                break;
+            }
+        }
+
+        while(x < nWidth && pRow[x] == 0)
+        {
+            x++;
+        }
+
+        if(x == nWidth)
+        {
+            break;
+        }
+
+        // extend a run over non-zero pixels
+        int x0 = x;
+
+        while(x < nWidth && pRow[x] != 0)
+        {
+            x++;
+        }
+
+        m_rRuns.push_back({nRow, x0, x - 1});
+    }
+}
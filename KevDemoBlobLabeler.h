@@ -0,0 +1,89 @@
+#ifndef _KEV_DEMO_BLOB_LABELER_H_
+#define _KEV_DEMO_BLOB_LABELER_H_
+
+#include "KevDemoConfig.h"
+
+/**
+ * @brief a class for labeling 8-connected components of a binary mask
+ *
+ * The mask is scanned once row by row. Each row is broken into runs of non-zero
+ * pixels, and runs touching a run of the previous row are merged by union-find.
+ * The bounding box and the area of every component are gathered without tracing
+ * contours, so that components can be rejected by their statistics first, and
+ * convex hulls are built only for the selected ones from the run end points.
+ */
+class KevDemoBlobLabeler
+{
+public:
+
+    /**
+     * @brief statistics of a connected component
+     */
+    typedef struct BlobStats {
+        cv::Rect boundingRect;
+        uint32_t area;
+    } BlobStats_t;
+
+private:
+
+    /**
+     * @brief a run of non-zero pixels on a row, from x0 to x1 inclusive
+     */
+    typedef struct BlobRun {
+        int y;
+        int x0;
+        int x1;
+    } BlobRun_t;
+
+    // runs of the mask in raster order
+    std::vector<BlobRun_t> m_rRuns;
+
+    // union-find parents of the runs
+    std::vector<uint32_t> m_rParents;
+
+    // component index of each root run
+    std::vector<int> m_rComponentIndices;
+
+    // statistics of the components in raster order of their first runs
+    std::vector<BlobStats_t> m_rComponents;
+
+    // hull slot of each component for buildHulls()
+    std::vector<int> m_rHullSlots;
+
+    // end points of the runs of the selected components, which are never shrunk
+    std::vector<std::vector<cv::Point> > m_rHullPoints;
+
+public:
+
+    explicit KevDemoBlobLabeler();
+    virtual ~KevDemoBlobLabeler();
+
+    // labeling procedures
+    KevDemoError_t label(const cv::Mat& rMask);
+    void buildHulls(const std::vector<uint32_t>& rSelected, std::vector<std::vector<cv::Point> >& rHulls);
+
+    // accessor
+    inline const std::vector<BlobStats_t>& getComponents()  { return m_rComponents; }
+
+private:
+
+    // find the root of a run with path halving
+    inline uint32_t findRoot(uint32_t nRun)
+    {
+        while(m_rParents[nRun] != nRun)
+        {
+            m_rParents[nRun] = m_rParents[m_rParents[nRun]];
+            nRun = m_rParents[nRun];
+        }
+
+        return nRun;
+    }
+
+    // merge the components of two runs
+    void unite(uint32_t nRun1, uint32_t nRun2);
+
+    // append the runs of a row
+    void extractRuns(const uint8_t *pRow, int nWidth, int nRow);
+};
+
+#endif // _KEV_DEMO_BLOB_LABELER_H_
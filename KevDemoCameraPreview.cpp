@@ -6,18 +6,16 @@
 
 KevDemoCameraPreview::KevDemoCameraPreview()
 {
-    // Create a camera preview
-    m_pCameraPreview = new cv::VideoCapture();
+    m_pCameraPreview = nullptr;
+    m_rStats.numFrames = 0;
+    m_rStats.numDropped = 0;
+    m_bIsRunning = false;
 }
 
 KevDemoCameraPreview::~KevDemoCameraPreview()
 {
     // Close and release a camera preview
-    if(m_pCameraPreview != nullptr)
-    {
-        close();
-        delete m_pCameraPreview;
-    }
+    close();
 }
 
 //////////////////////////////////////////////////
@@ -27,34 +25,36 @@ KevDemoCameraPreview::~KevDemoCameraPreview()
 /**
  * @brief This function opens to preview a camera.
  * @param nDevice camera device ID
+ * @param rCaptureSize capture resolution (an empty size for the camera default)
  * @return if a camera preview is opended well.
  */
 bool
-KevDemoCameraPreview::open(int nDevice)
+KevDemoCameraPreview::open(int nDevice, cv::Size rCaptureSize)
 {
-    if(m_pCameraPreview == nullptr)
-    {
-        return false;
-    }
+    close();
 
     // Open a camera preview obejct of the given device ID
-    if(m_pCameraPreview->open(nDevice) == false)
+    m_pCameraPreview = new KevDemoCaptureSource(nDevice, rCaptureSize);
+
+    if(m_pCameraPreview->open() != KEV_SUCCESS)
     {
+        delete m_pCameraPreview;
+        m_pCameraPreview = nullptr;
         return false;
     }
 
-    // Configure a timer (24~26 frames/sec)
-    QTimer *timer = new QTimer(this);
-    timer->setInterval(20);
-    connect(timer, SIGNAL(timeout()), this, SLOT(slot_updateFrame()));
+    {
+        QMutexLocker locker(&m_rMutex);
 
-    // Create a thread
-    m_pThread = new QThread();
-    timer->start();
-    timer->moveToThread(m_pThread);
+        m_rStats.numFrames = 0;
+        m_rStats.numDropped = 0;
+        m_rCrop = cv::Rect();
+    }
+
+    // Start the thread to capture frames off the GUI thread
+    m_bIsRunning = true;
+    this->start();
 
-    // Start the thread
-    m_pThread->start();
     return true;
 }
 
@@ -64,33 +64,95 @@ KevDemoCameraPreview::open(int nDevice)
 void
 KevDemoCameraPreview::close()
 {
+    // Stop the capture thread after its current read before releasing the camera
+    m_bIsRunning = false;
+    this->wait();
+
     // Close to preview a camera
-    if(m_pCameraPreview->isOpened())
+    if(m_pCameraPreview != nullptr)
     {
-        m_pCameraPreview->release();
+        m_pCameraPreview->close();
+
+        delete m_pCameraPreview;
+        m_pCameraPreview = nullptr;
     }
+}
+
+/**
+ * @brief This function returns the statistics of the capture.
+ * @return statistics of the capture
+ */
+KevDemoCaptureStats_t
+KevDemoCameraPreview::getStats()
+{
+    QMutexLocker locker(&m_rMutex);
 
-    // Close a thread for previewing camera frames
-    m_pThread->quit();
-    while(!m_pThread->isFinished());
+    return m_rStats;
 }
 
-//////////////////////////////////////////////////
-// Slot Function Definition
-//////////////////////////////////////////////////
+/**
+ * @brief This function requests a crop of the next frames, e.g. to the ROI blocks of a
+ *        VLC burst. It may be called on any thread.
+ * @param rCrop a crop of the frames (an empty rect for the whole frames)
+ */
+void
+KevDemoCameraPreview::slot_setCrop(QRect rCrop)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_rCrop = cv::Rect(rCrop.x(), rCrop.y(), rCrop.width(), rCrop.height());
+}
 
 /**
- * @brief This function is a slot function to be called when a frame receives.
+ * @brief This function runs the capture thread, which blocks on the camera until it
+ *        delivers the next frame.
  */
 void
-KevDemoCameraPreview::slot_updateFrame()
+KevDemoCameraPreview::run()
 {
-    // Capture a video frame
-    (*m_pCameraPreview) >> m_rPreviewFrame;
+    bool isFirstFrame = true;
+    uint64_t lastSequence = 0;
+    cv::Rect crop;
 
-    // Convert to a gray-colored image
-    cv::cvtColor(m_rPreviewFrame, m_rPreviewFrame, cv::COLOR_BGR2GRAY);
+    m_pCameraPreview->setCrop(crop);
 
-    // Emit a signal of frame capture
-    emit sig_receiveFrame(m_rPreviewFrame);
+    while(m_bIsRunning == true)
+    {
+        // Capture the luma of a video frame, taken from the Y plane of a YUV camera as it is
+        if(m_pCameraPreview->readFrame(m_rPreviewFrame) != KEV_SUCCESS)
+        {
+            QThread::msleep(KEV_CAMERA_RETRY_MS);
+            continue;
+        }
+
+        // A whole frame is handed out by its region of the crop in effect for the frame
+        if(m_rPreviewFrame.region.area() <= 0)
+        {
+            m_rPreviewFrame.region = crop & cv::Rect(0, 0, m_rPreviewFrame.image.cols, m_rPreviewFrame.image.rows);
+        }
+
+        {
+            QMutexLocker locker(&m_rMutex);
+
+            // Apply a new crop from the next frame
+            if(m_rCrop != crop)
+            {
+                crop = m_rCrop;
+                m_pCameraPreview->setCrop(crop);
+            }
+
+            m_rStats.numFrames++;
+
+            if(isFirstFrame == false && m_rPreviewFrame.sequence > lastSequence + 1)
+            {
+                m_rStats.numDropped += m_rPreviewFrame.sequence - lastSequence - 1;
+            }
+        }
+
+        isFirstFrame = false;
+        lastSequence = m_rPreviewFrame.sequence;
+
+        // Emit a signal of frame capture, whose receivers copy the frame to keep it
+        emit sig_receiveFrame(m_rPreviewFrame);
+    }
 }
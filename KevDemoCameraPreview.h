@@ -2,40 +2,77 @@
 #define _KEV_DEMO_CAMERA_PREVIEW_H_
 
 #include "KevDemoConfig.h"
+#include "KevDemoCaptureSource.h"
+
+#include <atomic>
+#include <QMutex>
+#include <QRect>
+
+// time to wait before reading again after a failed read in milliseconds
+#define KEV_CAMERA_RETRY_MS     10
+
+/**
+ * @brief statistics of a camera capture
+ */
+typedef struct KevDemoCaptureStats {
+    // number of captured frames
+    uint64_t numFrames;
+
+    // number of frames lost by the camera, counted from the gaps of the sequence
+    uint64_t numDropped;
+} KevDemoCaptureStats_t;
 
 /**
  * @brief a class for previewing a camera frame by frame
+ *
+ * The capture thread blocks on the camera for each frame instead of polling it on
+ * a timer, so every frame is read once as soon as the driver delivers it. A frame
+ * is stamped on the monotonic clock and numbered by the camera source, and emitted
+ * with sig_receiveFrame on the capture thread, whose receivers copy it into their
+ * queues. A frame is cropped as requested with slot_setCrop(), by the camera source
+ * where it converts the frame, and otherwise by its region, so that the receivers
+ * copy only the crop.
  */
-class KevDemoCameraPreview : public QObject
+class KevDemoCameraPreview : public QThread
 {
     Q_OBJECT
 
 private:
 
     // camera preview
-    cv::VideoCapture *m_pCameraPreview;
+    KevDemoCaptureSource *m_pCameraPreview;
+
+    // camera preview frame, whose luma views the buffers of the camera
+    KevDemoFrame_t m_rPreviewFrame;
 
-    // camera preview frame
-    cv::Mat m_rPreviewFrame;
+    // statistics and the requested crop shared with the other threads
+    QMutex m_rMutex;
+    KevDemoCaptureStats_t m_rStats;
+    cv::Rect m_rCrop;
 
-    // camera preview thread
-    QThread *m_pThread;
+    // capture flag, polled by the capture thread
+    std::atomic<bool> m_bIsRunning;
 
 public:
 
     explicit KevDemoCameraPreview();
     virtual ~KevDemoCameraPreview();
 
-    bool open(int nDevice = 0);
+    bool open(int nDevice = 0, cv::Size rCaptureSize = cv::Size());
     void close();
 
+    KevDemoCaptureStats_t getStats();
+
+    // thread
+    void run();
+
 signals:
 
-    void sig_receiveFrame(cv::Mat rMat);
+    void sig_receiveFrame(KevDemoFrame_t rFrame);
 
 public slots:
 
-    void slot_updateFrame();
+    void slot_setCrop(QRect rCrop);
 };
 
 #endif // _KEV_DEMO_CAMERA_PREVIEW_H_
@@ -0,0 +1,180 @@
+#include "KevDemoCaptureSource.h"
+
+#include <cmath>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoCaptureSource class for a camera
+ * @param nDevice camera device ID
+ * @param rCaptureSize capture resolution (an empty size for the camera default)
+ */
+KevDemoCaptureSource::KevDemoCaptureSource(int nDevice, cv::Size rCaptureSize)
+{
+    m_nDevice = nDevice;
+    m_rCaptureSize = rCaptureSize;
+    m_nFourCC = 0;
+    m_nLastTimestamp = 0;
+}
+
+/**
+ * @brief This is a constructor of KevDemoCaptureSource class for a video file
+ * @param rPath a video file or an image sequence pattern (e.g. frame_%04d.png)
+ */
+KevDemoCaptureSource::KevDemoCaptureSource(QString rPath)
+{
+    m_nDevice = -1;
+    m_rPath = rPath;
+    m_nFourCC = 0;
+    m_nLastTimestamp = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoCaptureSource class
+ */
+KevDemoCaptureSource::~KevDemoCaptureSource()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function opens the camera or the video file.
+ * @return error information
+ */
+KevDemoError_t
+KevDemoCaptureSource::open()
+{
+    close();
+
+    bool isOpened = (isCamera() == true) ? m_rCapture.open(m_nDevice) :
+                                           m_rCapture.open(m_rPath.toStdString());
+
+    if(isOpened == false)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    // Request the capture resolution, which the camera may round to a supported one
+    if(isCamera() == true && m_rCaptureSize.area() > 0)
+    {
+        m_rCapture.set(cv::CAP_PROP_FRAME_WIDTH, m_rCaptureSize.width);
+        m_rCapture.set(cv::CAP_PROP_FRAME_HEIGHT, m_rCaptureSize.height);
+    }
+
+    // Take the frames as the device or the codec delivers them, if the backend allows
+    m_rCapture.set(cv::CAP_PROP_CONVERT_RGB, 0);
+
+    m_rFrameSize = cv::Size((int)m_rCapture.get(cv::CAP_PROP_FRAME_WIDTH),
+                            (int)m_rCapture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    m_nFourCC = (int)m_rCapture.get(cv::CAP_PROP_FOURCC);
+
+    double fps = m_rCapture.get(cv::CAP_PROP_FPS);
+
+    restart((fps == fps) ? fps : 0);
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function reads the luma of the next frame.
+ * @param rFrame a read frame, which views the buffers of the source until the next read
+ * @return error information, KEV_ERROR_VLC_END_OF_SOURCE at the end of a video file
+ */
+KevDemoError_t
+KevDemoCaptureSource::readFrame(KevDemoFrame_t& rFrame)
+{
+    if(m_rCapture.isOpened() == false)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    if(m_rCapture.read(m_rRawFrame) == false || m_rRawFrame.empty() == true)
+    {
+        return KEV_ERROR_VLC_END_OF_SOURCE;
+    }
+
+    cv::Rect region = m_rCrop;
+    KevDemoError_t error = extractLuma(m_rRawFrame, m_rFrameSize, m_nFourCC, rFrame.image, m_rLumaBuffer, &region);
+
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
+
+    rFrame.region = region;
+
+    double position = m_rCapture.get(cv::CAP_PROP_POS_MSEC);
+
+    if(isCamera() == true)
+    {
+        // buffer time of the driver, or the time of the read
+        rFrame.timestamp = (position > 0) ? (int64_t)(position * 1e6) : getMonotonicTime();
+        rFrame.sequence = m_nSequence;
+
+        // skip the frame periods passed without a frame
+        if(m_nSequence > 0 && m_nFPS > 0)
+        {
+            double periods = (rFrame.timestamp - m_nLastTimestamp) * m_nFPS / 1e9;
+
+            if(periods >= 1.5)
+            {
+                rFrame.sequence += (uint64_t)std::llround(periods) - 1;
+            }
+        }
+
+        m_nLastTimestamp = rFrame.timestamp;
+        m_nSequence = rFrame.sequence + 1;
+    }
+    else
+    {
+        double index = m_rCapture.get(cv::CAP_PROP_POS_FRAMES) - 1;
+
+        rFrame.sequence = (index >= m_nSequence) ? (uint64_t)index : m_nSequence;
+        rFrame.timestamp = (position >= 0) ? (int64_t)(position * 1e6) : getNominalTime(rFrame.sequence);
+        m_nSequence = rFrame.sequence + 1;
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function closes the camera or the video file.
+ */
+void
+KevDemoCaptureSource::close()
+{
+    if(m_rCapture.isOpened() == true)
+    {
+        m_rCapture.release();
+    }
+}
+
+/**
+ * @brief This function requests a crop of the next frames, which is applied while
+ *        their luma is taken.
+ * @param rCrop a crop of the frames (an empty rect for the whole frames)
+ * @return true
+ */
+bool
+KevDemoCaptureSource::setCrop(cv::Rect rCrop)
+{
+    m_rCrop = rCrop;
+
+    return true;
+}
+
+/**
+ * @brief This function returns whether the camera or the video file is opened.
+ * @return true if opened, otherwise false
+ */
+bool
+KevDemoCaptureSource::isOpened()
+{
+    return m_rCapture.isOpened();
+}
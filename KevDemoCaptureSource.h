@@ -0,0 +1,64 @@
+#ifndef _KEV_DEMO_CAPTURE_SOURCE_H_
+#define _KEV_DEMO_CAPTURE_SOURCE_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoFrameSource.h"
+
+/**
+ * @brief a frame source of a camera device or a video file through cv::VideoCapture
+ *
+ * The backend is asked for the raw frames of the device or the codec instead of BGR,
+ * so a YUV frame is handed out as its Y plane without a color conversion. A camera
+ * frame is stamped on the monotonic clock with the buffer time of the driver if the
+ * backend provides it, and otherwise with the time it is read. Its sequence number
+ * advances by the frame periods elapsed since the previous frame, so the frames lost
+ * by the driver show up as gaps. A video frame is stamped with its position in the
+ * stream and numbered by its index.
+ *
+ * OpenCV does not expose a portable sensor window, so a crop is applied where the
+ * frame is first touched: only the crop of a packed or a BGR frame is converted
+ * into the luma buffer, while a planar Y plane is viewed as a whole anyway.
+ */
+class KevDemoCaptureSource : public KevDemoFrameSource
+{
+private:
+
+    // camera device ID (-1 for a video file) or a video file
+    int m_nDevice;
+    QString m_rPath;
+
+    // requested capture resolution (an empty size for the camera default)
+    cv::Size m_rCaptureSize;
+
+    cv::VideoCapture m_rCapture;
+
+    // frame size and pixel format delivered by the backend
+    cv::Size m_rFrameSize;
+    int m_nFourCC;
+
+    // timestamp of the previous frame
+    int64_t m_nLastTimestamp;
+
+    // raw frame and luma buffers
+    cv::Mat m_rRawFrame;
+    cv::Mat m_rLumaBuffer;
+
+public:
+
+    explicit KevDemoCaptureSource(int nDevice, cv::Size rCaptureSize = cv::Size());
+    explicit KevDemoCaptureSource(QString rPath);
+    virtual ~KevDemoCaptureSource();
+
+    // source procedures
+    KevDemoError_t open();
+    KevDemoError_t readFrame(KevDemoFrame_t& rFrame);
+    void close();
+    bool isOpened();
+    bool setCrop(cv::Rect rCrop);
+
+    // accessor
+    inline bool isCamera()                      { return m_nDevice >= 0;  }
+    inline cv::Size getFrameSize()              { return m_rFrameSize;    }
+};
+
+#endif // _KEV_DEMO_CAPTURE_SOURCE_H_
@@ -51,6 +51,11 @@ typedef enum KevDemoError {
     KEV_ERROR_UNKNOWN_VLC_DECODER,
     KEV_ERROR_UNKNOWN_VLC_STATE,
     KEV_ERROR_VLC_NOT_OPENED,
+    KEV_ERROR_VLC_SOURCE_NOT_OPENED,
+    KEV_ERROR_VLC_END_OF_SOURCE,
+    KEV_ERROR_VLC_SOURCE_READ,
+    KEV_ERROR_VLC_FRAME_TRUNCATED,
+    KEV_ERROR_VLC_FRAME_CORRUPTED,
 
     // for VBC
     KEV_ERROR_UNKNOWN_VBC_STATE,
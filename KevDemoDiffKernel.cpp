@@ -0,0 +1,194 @@
+#include "KevDemoDiffKernel.h"
+
+#include <algorithm>
+#include <opencv2/core/hal/intrin.hpp>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoDiffKernel class
+ */
+KevDemoDiffKernel::KevDemoDiffKernel()
+{
+    m_rPrevRowBuffer.clear();
+    m_rCurrRowBuffer.clear();
+}
+
+/**
+ * @brief This is a destructor of KevDemoDiffKernel class
+ */
+KevDemoDiffKernel::~KevDemoDiffKernel()
+{
+    m_rPrevRowBuffer.clear();
+    m_rCurrRowBuffer.clear();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function obtains a binary difference frame of the given frames.
+ *        It is equivalent to GaussianBlur(5x5) on both frames followed by absdiff and
+ *        threshold(THRESH_BINARY), but reads each input row only from cache and writes
+ *        each output pixel once. The blurred pixels are rounded half up from the exact
+ *        sums, whereas the rounding of GaussianBlur depends on the OpenCV version and
+ *        may differ by one level, so pixels whose difference is within two levels of
+ *        the threshold may be decided differently.
+ * @param rPrevFrame a previous frame (CV_8UC1)
+ * @param rCurrFrame a current frame (CV_8UC1)
+ * @param rDiffFrame a result difference frame
+ * @param nThreshold threshold to obtain a B&W difference frame
+ * @return error information
+ */
+KevDemoError_t
+KevDemoDiffKernel::apply(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame,
+                         cv::Mat& rDiffFrame, uint32_t nThreshold)
+{
+    if(rPrevFrame.empty() == true || rCurrFrame.empty() == true)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    if(rPrevFrame.size() != rCurrFrame.size() ||
+       rPrevFrame.type() != CV_8UC1 || rCurrFrame.type() != CV_8UC1)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    int rows = rCurrFrame.rows;
+    int cols = rCurrFrame.cols;
+
+    // the reflected border requires at least (radius + 1) pixels in each direction
+    if(rows <= KEV_DIFF_KERNEL_RADIUS || cols <= KEV_DIFF_KERNEL_RADIUS)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    // reallocated only when the frame size changes
+    rDiffFrame.create(rows, cols, CV_8UC1);
+
+    m_rPrevRowBuffer.resize(cols + 2 * KEV_DIFF_KERNEL_RADIUS);
+    m_rCurrRowBuffer.resize(cols + 2 * KEV_DIFF_KERNEL_RADIUS);
+
+    for(int y = 0; y < rows; y++)
+    {
+        filterColumns(rPrevFrame, y, m_rPrevRowBuffer.data());
+        filterColumns(rCurrFrame, y, m_rCurrRowBuffer.data());
+
+        filterRowsAndDiff(m_rPrevRowBuffer.data(), m_rCurrRowBuffer.data(),
+                          rDiffFrame.ptr<uint8_t>(y), cols, nThreshold);
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function filters the given row of a frame vertically and stores the result
+ *        into a row buffer padded with reflected borders of KEV_DIFF_KERNEL_RADIUS pixels.
+ * @param rFrame an image frame
+ * @param nRow a row index
+ * @param pRowBuffer a row buffer of (cols + 2 * KEV_DIFF_KERNEL_RADIUS) elements
+ */
+void
+KevDemoDiffKernel::filterColumns(const cv::Mat& rFrame, int nRow, uint16_t *pRowBuffer)
+{
+    int rows = rFrame.rows;
+    int cols = rFrame.cols;
+
+    const uint8_t *r0 = rFrame.ptr<uint8_t>(reflectIndex(nRow - 2, rows));
+    const uint8_t *r1 = rFrame.ptr<uint8_t>(reflectIndex(nRow - 1, rows));
+    const uint8_t *r2 = rFrame.ptr<uint8_t>(nRow);
+    const uint8_t *r3 = rFrame.ptr<uint8_t>(reflectIndex(nRow + 1, rows));
+    const uint8_t *r4 = rFrame.ptr<uint8_t>(reflectIndex(nRow + 2, rows));
+
+    uint16_t *dst = pRowBuffer + KEV_DIFF_KERNEL_RADIUS;
+    int x = 0;
+
+#if CV_SIMD128
+    for(; x <= cols - 8; x += 8)
+    {
+        cv::v_uint16x8 a0 = cv::v_load_expand(r0 + x);
+        cv::v_uint16x8 a1 = cv::v_load_expand(r1 + x);
+        cv::v_uint16x8 a2 = cv::v_load_expand(r2 + x);
+        cv::v_uint16x8 a3 = cv::v_load_expand(r3 + x);
+        cv::v_uint16x8 a4 = cv::v_load_expand(r4 + x);
+
+        // a0 + 4 * (a1 + a3) + 6 * a2 + a4 (max. 16 * 255)
+        cv::v_uint16x8 sum = a0 + a4 + cv::v_shl<2>(a1 + a3) +
+                             cv::v_shl<2>(a2) + cv::v_shl<1>(a2);
+
+        cv::v_store(dst + x, sum);
+    }
+#endif
+    for(; x < cols; x++)
+    {
+        dst[x] = (uint16_t)(r0[x] + r4[x] + 4 * (r1[x] + r3[x]) + 6 * r2[x]);
+    }
+
+    // reflected borders (BORDER_REFLECT_101)
+    dst[-1] = dst[1];
+    dst[-2] = dst[2];
+    dst[cols]     = dst[cols - 2];
+    dst[cols + 1] = dst[cols - 3];
+}
+
+/**
+ * @brief This function filters the vertically filtered rows horizontally, and then writes
+ *        255 into the difference row if the blurred pixels differ by more than the threshold.
+ * @param pPrevRow a vertically filtered row of the previous frame
+ * @param pCurrRow a vertically filtered row of the current frame
+ * @param pDiffRow an output row of the difference frame
+ * @param nCols the number of columns
+ * @param nThreshold threshold of the difference
+ */
+void
+KevDemoDiffKernel::filterRowsAndDiff(const uint16_t *pPrevRow, const uint16_t *pCurrRow,
+                                     uint8_t *pDiffRow, int nCols, uint32_t nThreshold)
+{
+    // nothing can exceed a threshold of 255 or more
+    uint16_t threshold = (uint16_t)std::min<uint32_t>(nThreshold, 255);
+    int x = 0;
+
+#if CV_SIMD128
+    cv::v_uint16x8 vRound = cv::v_setall_u16(128);
+    cv::v_uint16x8 vThreshold = cv::v_setall_u16(threshold);
+
+    for(; x <= nCols - 8; x += 8)
+    {
+        const uint16_t *p = pPrevRow + x;
+        const uint16_t *c = pCurrRow + x;
+
+        // p0 + 4 * (p1 + p3) + 6 * p2 + p4 (max. 16 * 16 * 255)
+        cv::v_uint16x8 p2 = cv::v_load(p + 2);
+        cv::v_uint16x8 c2 = cv::v_load(c + 2);
+
+        cv::v_uint16x8 prev = cv::v_load(p) + cv::v_load(p + 4) +
+                              cv::v_shl<2>(cv::v_load(p + 1) + cv::v_load(p + 3)) +
+                              cv::v_shl<2>(p2) + cv::v_shl<1>(p2);
+        cv::v_uint16x8 curr = cv::v_load(c) + cv::v_load(c + 4) +
+                              cv::v_shl<2>(cv::v_load(c + 1) + cv::v_load(c + 3)) +
+                              cv::v_shl<2>(c2) + cv::v_shl<1>(c2);
+
+        // normalize by 256 with rounding
+        prev = cv::v_shr<8>(prev + vRound);
+        curr = cv::v_shr<8>(curr + vRound);
+
+        // all-ones lanes saturate into 255 when packed
+        cv::v_uint16x8 mask = cv::v_absdiff(prev, curr) > vThreshold;
+        cv::v_store_low(pDiffRow + x, cv::v_pack(mask, mask));
+    }
+#endif
+    for(; x < nCols; x++)
+    {
+        const uint16_t *p = pPrevRow + x;
+        const uint16_t *c = pCurrRow + x;
+
+        int prev = (p[0] + p[4] + 4 * (p[1] + p[3]) + 6 * p[2] + 128) >> 8;
+        int curr = (c[0] + c[4] + 4 * (c[1] + c[3]) + 6 * c[2] + 128) >> 8;
+
+        pDiffRow[x] = (std::abs(prev - curr) > threshold) ? 255 : 0;
+    }
+}
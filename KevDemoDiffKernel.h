@@ -0,0 +1,57 @@
+#ifndef _KEV_DEMO_DIFF_KERNEL_H_
+#define _KEV_DEMO_DIFF_KERNEL_H_
+
+#include "KevDemoConfig.h"
+
+// size of the gaussian kernel fused into the difference kernel (5x5, sigma 0)
+#define KEV_DIFF_KERNEL_SIZE    5
+#define KEV_DIFF_KERNEL_RADIUS  (KEV_DIFF_KERNEL_SIZE/2)
+
+/**
+ * @brief a class for obtaining a binary difference frame in a single pass
+ *
+ * The kernel fuses GaussianBlur(5x5) of both frames, absdiff and a binary
+ * threshold into one streaming pass over the rows of the input frames.
+ * The input frames are never modified.
+ */
+class KevDemoDiffKernel
+{
+private:
+
+    // vertically filtered rows of the previous and current frames
+    std::vector<uint16_t> m_rPrevRowBuffer;
+    std::vector<uint16_t> m_rCurrRowBuffer;
+
+public:
+
+    explicit KevDemoDiffKernel();
+    virtual ~KevDemoDiffKernel();
+
+    // obtain a binary difference frame
+    KevDemoError_t apply(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame,
+                         cv::Mat& rDiffFrame, uint32_t nThreshold);
+
+private:
+
+    // filter a row vertically with a [1 4 6 4 1] kernel
+    void filterColumns(const cv::Mat& rFrame, int nRow, uint16_t *pRowBuffer);
+
+    // filter two rows horizontally, and then threshold their difference
+    void filterRowsAndDiff(const uint16_t *pPrevRow, const uint16_t *pCurrRow,
+                           uint8_t *pDiffRow, int nCols, uint32_t nThreshold);
+
+    /**
+     * @brief This function returns a reflected index (BORDER_REFLECT_101) within [0, nSize).
+     * @param nIndex an index to be reflected
+     * @param nSize the number of elements
+     * @return a reflected index
+     */
+    static inline int reflectIndex(int nIndex, int nSize)
+    {
+        if(nIndex < 0)      return -nIndex;
+        if(nIndex >= nSize) return 2 * nSize - nIndex - 2;
+        return nIndex;
+    }
+};
+
+#endif // _KEV_DEMO_DIFF_KERNEL_H_
@@ -0,0 +1,143 @@
+#include "KevDemoFrameArena.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoFrameArena class
+ * @param nNumFrames the number of frames in the ring (at least 2)
+ * @param nNumScratches the number of scratch buffers
+ */
+KevDemoFrameArena::KevDemoFrameArena(uint32_t nNumFrames, uint32_t nNumScratches)
+{
+    m_rFrameRing.resize(std::max<uint32_t>(nNumFrames, 2));
+    m_rScratches.resize(nNumScratches);
+    m_nRingIndex = 0;
+    m_nNumReallocations = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoFrameArena class
+ */
+KevDemoFrameArena::~KevDemoFrameArena()
+{
+    release();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function copies the given frame into the next buffer of the ring.
+ *        The buffer of the oldest frame is reused, so no memory is allocated
+ *        unless the frame size or type changes.
+ * @param rFrame a frame to be retained
+ * @return the retained frame
+ */
+cv::Mat&
+KevDemoFrameArena::pushFrame(const cv::Mat& rFrame)
+{
+    m_nRingIndex = (m_nRingIndex + 1) % m_rFrameRing.size();
+
+    cv::Mat& buffer = m_rFrameRing[m_nRingIndex];
+    reserve(buffer, rFrame.size(), rFrame.type());
+    rFrame.copyTo(buffer);
+
+    return buffer;
+}
+
+/**
+ * @brief This function copies only the region of the given frame into the next buffer
+ *        of the ring, whose pixels out of the region are left from an older frame.
+ * @param rFrame a frame to be retained
+ * @param rRegion region of the frame to be retained
+ * @return the retained frame
+ */
+cv::Mat&
+KevDemoFrameArena::pushFrame(const cv::Mat& rFrame, cv::Rect rRegion)
+{
+    rRegion &= cv::Rect(0, 0, rFrame.cols, rFrame.rows);
+
+    if(rRegion.area() <= 0)
+    {
+        return pushFrame(rFrame);
+    }
+
+    m_nRingIndex = (m_nRingIndex + 1) % m_rFrameRing.size();
+
+    cv::Mat& buffer = m_rFrameRing[m_nRingIndex];
+    reserve(buffer, rFrame.size(), rFrame.type());
+
+    cv::Mat bufferRegion = buffer(rRegion);
+    rFrame(rRegion).copyTo(bufferRegion);
+
+    return buffer;
+}
+
+/**
+ * @brief This function returns a frame in the ring.
+ * @param nAge 0 for the latest frame, 1 for the frame before it, and so on
+ * @return a frame of the ring
+ */
+cv::Mat&
+KevDemoFrameArena::getFrame(uint32_t nAge)
+{
+    uint32_t size = m_rFrameRing.size();
+    return m_rFrameRing[(m_nRingIndex + size - (nAge % size)) % size];
+}
+
+/**
+ * @brief This function returns a scratch buffer of the given size and type.
+ *        The contents of the buffer are kept if its size and type are unchanged.
+ * @param nSlot scratch slot
+ * @param rSize buffer size
+ * @param nType buffer type
+ * @return a scratch buffer
+ */
+cv::Mat&
+KevDemoFrameArena::getScratch(uint32_t nSlot, cv::Size rSize, int nType)
+{
+    cv::Mat& buffer = m_rScratches[nSlot];
+    reserve(buffer, rSize, nType);
+
+    return buffer;
+}
+
+/**
+ * @brief This function releases all the buffers of the arena.
+ */
+void
+KevDemoFrameArena::release()
+{
+    for(cv::Mat &frame : m_rFrameRing)
+    {
+        frame.release();
+    }
+
+    for(cv::Mat &scratch : m_rScratches)
+    {
+        scratch.release();
+    }
+}
+
+/**
+ * @brief This function reallocates a buffer if its size or type differs from the given ones.
+ * @param rBuffer a buffer
+ * @param rSize buffer size
+ * @param nType buffer type
+ */
+void
+KevDemoFrameArena::reserve(cv::Mat& rBuffer, cv::Size rSize, int nType)
+{
+    if(rBuffer.empty() == false && rBuffer.size() == rSize && rBuffer.type() == nType)
+    {
+        return;
+    }
+
+    rBuffer.create(rSize, nType);
+    m_nNumReallocations++;
+}
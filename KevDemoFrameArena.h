@@ -0,0 +1,55 @@
+#ifndef _KEV_DEMO_FRAME_ARENA_H_
+#define _KEV_DEMO_FRAME_ARENA_H_
+
+#include "KevDemoConfig.h"
+
+/**
+ * @brief a class for preallocated frame buffers of a decoder
+ *
+ * The arena owns a small ring of frame buffers and a set of scratch buffers
+ * indexed by slot. Buffers are reallocated only when the requested size or
+ * type changes, and every reallocation is counted so that the steady state
+ * of a decoder can be checked to reuse its buffers. Allocations made outside
+ * the arena, e.g. by OpenCV internals or containers, are not counted.
+ */
+class KevDemoFrameArena
+{
+private:
+
+    // ring of frame buffers
+    std::vector<cv::Mat> m_rFrameRing;
+
+    // index of the latest frame in the ring
+    uint32_t m_nRingIndex;
+
+    // scratch buffers
+    std::vector<cv::Mat> m_rScratches;
+
+    // number of buffer (re)allocations
+    uint64_t m_nNumReallocations;
+
+public:
+
+    explicit KevDemoFrameArena(uint32_t nNumFrames, uint32_t nNumScratches);
+    virtual ~KevDemoFrameArena();
+
+    // frame ring
+    cv::Mat& pushFrame(const cv::Mat& rFrame);
+    cv::Mat& pushFrame(const cv::Mat& rFrame, cv::Rect rRegion);
+    cv::Mat& getFrame(uint32_t nAge = 0);
+
+    // scratch buffers
+    cv::Mat& getScratch(uint32_t nSlot, cv::Size rSize, int nType);
+
+    void release();
+
+    // accessor
+    inline uint64_t getNumReallocations()   { return m_nNumReallocations; }
+
+private:
+
+    // reallocate a buffer if its size or type differs
+    void reserve(cv::Mat& rBuffer, cv::Size rSize, int nType);
+};
+
+#endif // _KEV_DEMO_FRAME_ARENA_H_
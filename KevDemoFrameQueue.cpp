@@ -0,0 +1,235 @@
+#include "KevDemoFrameQueue.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoFrameQueue class
+ * @param nCapacity the maximum number of queued frames (at least 1)
+ */
+KevDemoFrameQueue::KevDemoFrameQueue(uint32_t nCapacity)
+{
+    m_rSlots.resize(std::max<uint32_t>(nCapacity, 1));
+    m_nHead = 0;
+    m_nCount = 0;
+    m_nNumDropped = 0;
+    m_bIsClosed = false;
+}
+
+/**
+ * @brief This is a destructor of KevDemoFrameQueue class
+ */
+KevDemoFrameQueue::~KevDemoFrameQueue()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function pushes a copy of the given frame. The oldest frame is dropped
+ *        if the queue is full.
+ * @param rFrame a frame to be queued
+ * @param rRegion region of the frame to copy (an empty rect for the whole frame)
+ * @return the number of queued frames including the pushed one
+ */
+uint32_t
+KevDemoFrameQueue::push(const cv::Mat& rFrame, cv::Rect rRegion)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    KevDemoFrame_t &slot = pushSlot();
+
+    KevDemoFrameSource::copyRegion(rFrame, rRegion, slot.image);
+    slot.timestamp = 0;
+    slot.sequence = 0;
+    slot.region = rRegion;
+
+    return m_nCount;
+}
+
+/**
+ * @brief This function pushes a copy of the given timestamped frame. The oldest frame
+ *        is dropped if the queue is full.
+ * @param rFrame a frame to be queued, of which only the region is copied
+ * @return the number of queued frames including the pushed one
+ */
+uint32_t
+KevDemoFrameQueue::push(const KevDemoFrame_t& rFrame)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    KevDemoFrame_t &slot = pushSlot();
+
+    KevDemoFrameSource::copyRegion(rFrame.image, rFrame.region, slot.image);
+    slot.timestamp = rFrame.timestamp;
+    slot.sequence = rFrame.sequence;
+    slot.region = rFrame.region;
+
+    return m_nCount;
+}
+
+/**
+ * @brief This function pops the oldest frame. The buffer of the given frame is
+ *        swapped into the slot to be reused by a later push.
+ * @param rFrame a popped frame
+ * @param nTimeout time to wait for a frame in milliseconds (0 for no wait)
+ * @return true if a frame is popped, otherwise false
+ */
+bool
+KevDemoFrameQueue::pop(cv::Mat& rFrame, unsigned long nTimeout)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    KevDemoFrame_t *slot = popSlot(nTimeout);
+
+    if(slot == nullptr)
+    {
+        return false;
+    }
+
+    std::swap(rFrame, slot->image);
+
+    return true;
+}
+
+/**
+ * @brief This function pops the oldest frame with its timestamp. The buffer of the
+ *        given frame is swapped into the slot to be reused by a later push.
+ * @param rFrame a popped frame
+ * @param nTimeout time to wait for a frame in milliseconds (0 for no wait)
+ * @return true if a frame is popped, otherwise false
+ */
+bool
+KevDemoFrameQueue::pop(KevDemoFrame_t& rFrame, unsigned long nTimeout)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    KevDemoFrame_t *slot = popSlot(nTimeout);
+
+    if(slot == nullptr)
+    {
+        return false;
+    }
+
+    std::swap(rFrame.image, slot->image);
+    rFrame.timestamp = slot->timestamp;
+    rFrame.sequence = slot->sequence;
+    rFrame.region = slot->region;
+
+    return true;
+}
+
+/**
+ * @brief This function drops all the queued frames.
+ */
+void
+KevDemoFrameQueue::clear()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_nHead = 0;
+    m_nCount = 0;
+}
+
+/**
+ * @brief This function opens the queue for a consumer to wait on.
+ */
+void
+KevDemoFrameQueue::open()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_bIsClosed = false;
+}
+
+/**
+ * @brief This function closes the queue and wakes up a waiting consumer.
+ */
+void
+KevDemoFrameQueue::close()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_bIsClosed = true;
+    m_rNotEmpty.wakeAll();
+}
+
+/**
+ * @brief This function returns the number of queued frames.
+ * @return the number of queued frames
+ */
+uint32_t
+KevDemoFrameQueue::getNumFrames()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    return m_nCount;
+}
+
+/**
+ * @brief This function returns the number of frames dropped by the drop-oldest policy.
+ * @return the number of dropped frames
+ */
+uint64_t
+KevDemoFrameQueue::getNumDropped()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    return m_nNumDropped;
+}
+
+/**
+ * @brief This function takes the slot of the next frame and wakes up the consumer.
+ *        The oldest frame is dropped if the queue is full. The mutex must be locked.
+ * @return the slot of the next frame
+ */
+KevDemoFrame_t&
+KevDemoFrameQueue::pushSlot()
+{
+    if(m_nCount == m_rSlots.size())
+    {
+        m_nHead = (m_nHead + 1) % m_rSlots.size();
+        m_nCount--;
+        m_nNumDropped++;
+    }
+
+    KevDemoFrame_t &slot = m_rSlots[(m_nHead + m_nCount) % m_rSlots.size()];
+    m_nCount++;
+
+    m_rNotEmpty.wakeOne();
+
+    return slot;
+}
+
+/**
+ * @brief This function takes the slot of the oldest frame, waiting for a frame if the
+ *        queue is empty. The mutex must be locked.
+ * @param nTimeout time to wait for a frame in milliseconds (0 for no wait)
+ * @return the slot of the oldest frame, or nullptr if no frame is queued
+ */
+KevDemoFrame_t*
+KevDemoFrameQueue::popSlot(unsigned long nTimeout)
+{
+    if(m_nCount == 0 && m_bIsClosed == false && nTimeout > 0)
+    {
+        m_rNotEmpty.wait(&m_rMutex, nTimeout);
+    }
+
+    if(m_nCount == 0)
+    {
+        return nullptr;
+    }
+
+    KevDemoFrame_t *slot = &m_rSlots[m_nHead];
+
+    m_nHead = (m_nHead + 1) % m_rSlots.size();
+    m_nCount--;
+
+    return slot;
+}
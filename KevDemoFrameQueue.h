@@ -0,0 +1,69 @@
+#ifndef _KEV_DEMO_FRAME_QUEUE_H_
+#define _KEV_DEMO_FRAME_QUEUE_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoFrameSource.h"
+
+#include <QMutex>
+#include <QWaitCondition>
+
+/**
+ * @brief a class for a bounded frame queue between pipeline stages
+ *
+ * The queue keeps a fixed number of frame slots. When a frame is pushed into
+ * a full queue, the oldest frame is dropped so that a slow consumer always
+ * works on recent frames instead of falling further behind. Frames are copied
+ * into the slots and swapped out on pop, so the slot buffers are reused once
+ * the frame size is stable. Only the region of a cropped frame is copied, over
+ * the pixels of an earlier frame in its slot. A timestamped frame keeps its
+ * timestamp, sequence number and region through the queue.
+ */
+class KevDemoFrameQueue
+{
+private:
+
+    QMutex m_rMutex;
+    QWaitCondition m_rNotEmpty;
+
+    // frame slots
+    std::vector<KevDemoFrame_t> m_rSlots;
+
+    // index of the oldest frame and the number of queued frames
+    uint32_t m_nHead;
+    uint32_t m_nCount;
+
+    // number of frames dropped by the drop-oldest policy
+    uint64_t m_nNumDropped;
+
+    // closed queue wakes up its consumer
+    bool m_bIsClosed;
+
+public:
+
+    explicit KevDemoFrameQueue(uint32_t nCapacity);
+    virtual ~KevDemoFrameQueue();
+
+    // queue operations
+    uint32_t push(const cv::Mat& rFrame, cv::Rect rRegion = cv::Rect());
+    uint32_t push(const KevDemoFrame_t& rFrame);
+    bool pop(cv::Mat& rFrame, unsigned long nTimeout = 0);
+    bool pop(KevDemoFrame_t& rFrame, unsigned long nTimeout = 0);
+    void clear();
+
+    void open();
+    void close();
+
+    // accessor
+    uint32_t getNumFrames();
+    uint64_t getNumDropped();
+
+private:
+
+    // take the slot of the next frame, dropping the oldest one if the queue is full
+    KevDemoFrame_t& pushSlot();
+
+    // take the slot of the oldest frame
+    KevDemoFrame_t* popSlot(unsigned long nTimeout);
+};
+
+#endif // _KEV_DEMO_FRAME_QUEUE_H_
@@ -0,0 +1,186 @@
+#include "KevDemoFrameRing.h"
+
+#include <QThread>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoFrameRing class
+ * @param nCapacity the number of frame slots, rounded up to a power of two of at least two
+ */
+KevDemoFrameRing::KevDemoFrameRing(uint32_t nCapacity)
+{
+    // two slots at least, so that a dropped frame always leaves a permit to take back
+    uint64_t capacity = 2;
+
+    while(capacity < nCapacity)
+    {
+        capacity <<= 1;
+    }
+
+    m_rSlots.resize(capacity);
+    m_nMask = capacity - 1;
+
+    // each slot is first written by the push of its index
+    m_pSlotSeqs = new std::atomic<uint64_t>[capacity];
+
+    for(uint64_t i = 0; i < capacity; i++)
+    {
+        m_pSlotSeqs[i] = i;
+    }
+
+    m_nHead = 0;
+    m_nTail = 0;
+    m_nNumDropped = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoFrameRing class
+ */
+KevDemoFrameRing::~KevDemoFrameRing()
+{
+    delete[] m_pSlotSeqs;
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function copies a frame into the ring. On a full ring the oldest frame is
+ *        dropped for it, unless the consumer has just taken that frame. It is called
+ *        only by the producer.
+ * @param rFrame a frame
+ * @return true if the frame is queued without dropping another one, otherwise false
+ */
+bool
+KevDemoFrameRing::push(const KevDemoFrame_t& rFrame)
+{
+    bool isDropped = false;
+    uint64_t head = m_nHead.load(std::memory_order_relaxed);
+    uint64_t tail = m_nTail.load(std::memory_order_acquire);
+
+    if(head - tail > m_nMask)
+    {
+        // a failed claim means the consumer has popped the oldest frame instead
+        if(m_nTail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel) == true)
+        {
+            m_pSlotSeqs[tail & m_nMask].store(tail + m_nMask + 1, std::memory_order_release);
+
+            // take back the permit of the dropped frame
+            m_rNumFrames.tryAcquire(1);
+            m_nNumDropped.fetch_add(1, std::memory_order_relaxed);
+            isDropped = true;
+        }
+    }
+
+    // the consumer may still be swapping out the last frame of the slot, for a few
+    // instructions only
+    std::atomic<uint64_t> &sequence = m_pSlotSeqs[head & m_nMask];
+
+    while(sequence.load(std::memory_order_acquire) != head)
+    {
+        QThread::yieldCurrentThread();
+    }
+
+    KevDemoFrame_t &slot = m_rSlots[head & m_nMask];
+
+    // only the region of a cropped frame is copied
+    KevDemoFrameSource::copyRegion(rFrame.image, rFrame.region, slot.image);
+    slot.timestamp = rFrame.timestamp;
+    slot.sequence = rFrame.sequence;
+    slot.region = rFrame.region;
+
+    m_nHead.store(head + 1, std::memory_order_release);
+    m_rNumFrames.release();
+
+    return (isDropped == false);
+}
+
+/**
+ * @brief This function takes the oldest frame. The frame is swapped with the given one,
+ *        whose buffer is reused by a later push. It is called only by the consumer.
+ * @param rFrame the oldest frame
+ * @param nTimeout time to wait for a frame in milliseconds (0 to return at once)
+ * @return true if a frame is popped, otherwise false
+ */
+bool
+KevDemoFrameRing::pop(KevDemoFrame_t& rFrame, int nTimeout)
+{
+    // a permit is released after the head of its frame, so the claimed frame is written
+    if(m_rNumFrames.tryAcquire(1, nTimeout) == false)
+    {
+        return false;
+    }
+
+    uint64_t tail = claimTail();
+    KevDemoFrame_t &slot = m_rSlots[tail & m_nMask];
+
+    std::swap(rFrame.image, slot.image);
+    rFrame.timestamp = slot.timestamp;
+    rFrame.sequence = slot.sequence;
+    rFrame.region = slot.region;
+
+    // hand the slot over to the push one lap later
+    m_pSlotSeqs[tail & m_nMask].store(tail + m_nMask + 1, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief This function drops the queued frames. It is called only by the consumer, or
+ *        while neither side is running.
+ */
+void
+KevDemoFrameRing::clear()
+{
+    while(m_rNumFrames.tryAcquire(1) == true)
+    {
+        uint64_t tail = claimTail();
+
+        m_pSlotSeqs[tail & m_nMask].store(tail + m_nMask + 1, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief This function returns the number of queued frames, which may change at once.
+ * @return the number of queued frames
+ */
+uint32_t
+KevDemoFrameRing::getNumFrames()
+{
+    // the tail is read first not to pass the head
+    uint64_t tail = m_nTail.load(std::memory_order_acquire);
+
+    return (uint32_t)(m_nHead.load(std::memory_order_acquire) - tail);
+}
+
+/**
+ * @brief This function returns the number of frames dropped on a full ring.
+ * @return the number of dropped frames
+ */
+uint64_t
+KevDemoFrameRing::getNumDropped()
+{
+    return m_nNumDropped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief This function claims the oldest frame against the producer dropping it. It is
+ *        called only by the consumer holding a permit, so a frame is always left.
+ * @return the index of the claimed frame
+ */
+uint64_t
+KevDemoFrameRing::claimTail()
+{
+    uint64_t tail = m_nTail.load(std::memory_order_relaxed);
+
+    while(m_nTail.compare_exchange_weak(tail, tail + 1, std::memory_order_acquire,
+                                        std::memory_order_relaxed) == false)
+    {
+    }
+
+    return tail;
+}
@@ -0,0 +1,66 @@
+#ifndef _KEV_DEMO_FRAME_RING_H_
+#define _KEV_DEMO_FRAME_RING_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoFrameSource.h"
+
+#include <atomic>
+#include <QSemaphore>
+
+/**
+ * @brief a lock-free ring of frames between a single producer and a single consumer
+ *
+ * The capture thread pushes frames and a single decode thread pops them, without a
+ * lock on either side. The consumer may block on a semaphore counting the published
+ * frames. A frame is claimed by advancing the tail with a compare-and-swap, either by
+ * the consumer to pop it or by the producer to drop it on a full ring, so the oldest
+ * frame is dropped and the newest is always queued. The sequence number of a slot
+ * tells the producer which push may write it. The consumer advances it once it has
+ * swapped the frame out, so the slot buffers are reused once the frame size is
+ * stable. The sequence numbers of the frames still show the gap of a dropped frame.
+ */
+class KevDemoFrameRing
+{
+private:
+
+    // frame slots (a power of two)
+    std::vector<KevDemoFrame_t> m_rSlots;
+    uint64_t m_nMask;
+
+    // the push which may write each slot, advanced when the frame in the slot is taken
+    std::atomic<uint64_t> *m_pSlotSeqs;
+
+    // the number of frames pushed, written only by the producer
+    std::atomic<uint64_t> m_nHead;
+
+    // the number of frames popped or dropped, claimed by the consumer and the producer
+    std::atomic<uint64_t> m_nTail;
+
+    // the number of frames dropped on a full ring
+    std::atomic<uint64_t> m_nNumDropped;
+
+    // published frames to wake up the consumer
+    QSemaphore m_rNumFrames;
+
+public:
+
+    explicit KevDemoFrameRing(uint32_t nCapacity);
+    virtual ~KevDemoFrameRing();
+
+    // producer
+    bool push(const KevDemoFrame_t& rFrame);
+
+    // consumer
+    bool pop(KevDemoFrame_t& rFrame, int nTimeout = 0);
+    void clear();
+
+    // accessor
+    uint32_t getNumFrames();
+    uint64_t getNumDropped();
+
+private:
+
+    uint64_t claimTail();
+};
+
+#endif // _KEV_DEMO_FRAME_RING_H_
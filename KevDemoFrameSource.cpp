@@ -0,0 +1,259 @@
+#include "KevDemoFrameSource.h"
+#include "KevDemoCaptureSource.h"
+#include "KevDemoImageSource.h"
+
+#include <QFileInfo>
+#include <chrono>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoFrameSource class
+ */
+KevDemoFrameSource::KevDemoFrameSource()
+{
+    m_nSequence = 0;
+    m_nFPS = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoFrameSource class
+ */
+KevDemoFrameSource::~KevDemoFrameSource()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function creates a source of a path, which is not opened yet.
+ * @param rPath a camera (camera:N), a directory of images, a video file, or an image
+ *        sequence pattern (e.g. frame_%04d.png)
+ * @return a frame source to be deleted by the caller
+ */
+KevDemoFrameSource *
+KevDemoFrameSource::create(QString rPath)
+{
+    if(rPath.startsWith(KEV_FRAME_SOURCE_CAMERA_PREFIX) == true)
+    {
+        bool isNumber = false;
+        int device = rPath.mid(QString(KEV_FRAME_SOURCE_CAMERA_PREFIX).size()).toInt(&isNumber);
+
+        if(isNumber == true)
+        {
+            return new KevDemoCaptureSource(device);
+        }
+    }
+
+    if(QFileInfo(rPath).isDir() == true)
+    {
+        return new KevDemoImageSource(rPath);
+    }
+
+    return new KevDemoCaptureSource(rPath);
+}
+
+/**
+ * @brief This function takes the luma of a frame. A raw buffer is recognized by its
+ *        size: a gray or planar YUV (I420, YV12, NV12, NV21) buffer is viewed without
+ *        a copy, the Y samples of a packed 4:2:2 buffer (YUYV, UYVY) are gathered, and
+ *        a MJPEG buffer is decoded into gray. A BGR(A) frame of a backend which always
+ *        converts is converted into gray. Only the crop of a frame is gathered or
+ *        converted if requested, while a view or a decoded frame is taken as a whole.
+ * @param rRaw a captured or decoded frame
+ * @param rFrameSize frame size of the source (an empty size if unknown)
+ * @param nFourCC pixel format of the source (0 if unknown)
+ * @param rLuma luma plane (CV_8UC1), which may view rRaw or rBuffer
+ * @param rBuffer buffer of the luma plane if it cannot view rRaw
+ * @param pRegion a crop to take (nullptr or an empty rect for the whole frame), which
+ *        is replaced by the region of rLuma taken from the frame
+ * @return error information, KEV_ERROR_VLC_SOURCE_READ if the raw buffer is not recognized
+ *         or cannot be decoded
+ */
+KevDemoError_t
+KevDemoFrameSource::extractLuma(const cv::Mat& rRaw, cv::Size rFrameSize, int nFourCC,
+                                cv::Mat& rLuma, cv::Mat& rBuffer, cv::Rect *pRegion)
+{
+    if(rRaw.empty() == true || rRaw.depth() != CV_8U)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    // a crop is taken only inside the frame, and the whole frame is taken otherwise
+    cv::Size size = (rRaw.channels() >= 3 || rFrameSize.area() <= 0) ? rRaw.size() : rFrameSize;
+    cv::Rect crop;
+
+    if(pRegion != nullptr)
+    {
+        if(pRegion->area() > 0 && (*pRegion & cv::Rect(0, 0, size.width, size.height)) == *pRegion)
+        {
+            crop = *pRegion;
+        }
+
+        *pRegion = cv::Rect();
+    }
+
+    if(rRaw.channels() == 3 || rRaw.channels() == 4)
+    {
+        int code = (rRaw.channels() == 3) ? cv::COLOR_BGR2GRAY : cv::COLOR_BGRA2GRAY;
+
+        if(crop.area() > 0)
+        {
+            // the pixels out of the crop are left in the buffer of the same size
+            rBuffer.create(size, CV_8UC1);
+
+            cv::Mat lumaRegion = rBuffer(crop);
+            cv::cvtColor(rRaw(crop), lumaRegion, code);
+            *pRegion = crop;
+        }
+        else
+        {
+            cv::cvtColor(rRaw, rBuffer, code);
+        }
+
+        rLuma = rBuffer;
+        return KEV_SUCCESS;
+    }
+
+    // a decoded or a shaped frame of the source size
+    if(rFrameSize.area() <= 0 || (rRaw.rows == rFrameSize.height && rRaw.cols == rFrameSize.width))
+    {
+        if(rRaw.channels() == 1)
+        {
+            rLuma = rRaw;
+            return KEV_SUCCESS;
+        }
+    }
+
+    // a raw buffer is recognized by its size
+    if(rRaw.isContinuous() == false)
+    {
+        return KEV_ERROR_VLC_SOURCE_READ;
+    }
+
+    size_t numBytes = rRaw.total() * rRaw.elemSize();
+    size_t numPixels = (size_t)rFrameSize.area();
+
+    if(nFourCC == cv::VideoWriter::fourcc('M', 'J', 'P', 'G'))
+    {
+        // only the Y components are transformed into gray
+        cv::imdecode(rRaw.reshape(1, 1), cv::IMREAD_GRAYSCALE, &rBuffer);
+        rLuma = rBuffer;
+    }
+    else if(numBytes == numPixels || numBytes == numPixels * 3 / 2)
+    {
+        // gray or planar YUV with the Y plane first
+        rLuma = rRaw.reshape(1, 1).colRange(0, (int)numPixels).reshape(1, rFrameSize.height);
+    }
+    else if(numBytes == numPixels * 2)
+    {
+        // packed 4:2:2 with Y in every other byte
+        int index = (nFourCC == cv::VideoWriter::fourcc('U', 'Y', 'V', 'Y')) ? 1 : 0;
+        cv::Mat packed = rRaw.reshape(2, rFrameSize.height);
+
+        if(crop.area() > 0)
+        {
+            rBuffer.create(size, CV_8UC1);
+
+            cv::Mat lumaRegion = rBuffer(crop);
+            cv::extractChannel(packed(crop), lumaRegion, index);
+            *pRegion = crop;
+        }
+        else
+        {
+            cv::extractChannel(packed, rBuffer, index);
+        }
+
+        rLuma = rBuffer;
+    }
+    else
+    {
+        return KEV_ERROR_VLC_SOURCE_READ;
+    }
+
+    return (rLuma.empty() == true) ? KEV_ERROR_VLC_SOURCE_READ : KEV_SUCCESS;
+}
+
+/**
+ * @brief This function copies the region of a frame into a buffer of the frame size,
+ *        which keeps the pixels out of the region. A buffer is cleared when allocated,
+ *        so that no uninitialized pixels are shown.
+ * @param rFrame a frame
+ * @param rRegion region of the frame to copy (an empty rect for the whole frame)
+ * @param rBuffer a buffer of the frame
+ */
+void
+KevDemoFrameSource::copyRegion(const cv::Mat& rFrame, cv::Rect rRegion, cv::Mat& rBuffer)
+{
+    rRegion &= cv::Rect(0, 0, rFrame.cols, rFrame.rows);
+
+    if(rRegion.area() <= 0 || rRegion.area() == (int)rFrame.total())
+    {
+        rFrame.copyTo(rBuffer);
+        return;
+    }
+
+    if(rBuffer.size() != rFrame.size() || rBuffer.type() != rFrame.type())
+    {
+        rBuffer.create(rFrame.size(), rFrame.type());
+        rBuffer.setTo(cv::Scalar::all(0));
+    }
+
+    cv::Mat bufferRegion = rBuffer(rRegion);
+    rFrame(rRegion).copyTo(bufferRegion);
+}
+
+/**
+ * @brief This function requests a crop of the next frames. A source which cannot crop
+ *        hands out the whole frames.
+ * @param rCrop a crop of the frames (an empty rect for the whole frames)
+ * @return true if the source crops its frames, otherwise false
+ */
+bool
+KevDemoFrameSource::setCrop(cv::Rect rCrop)
+{
+    m_rCrop = cv::Rect();
+
+    return (rCrop.area() <= 0);
+}
+
+/**
+ * @brief This function starts a new sequence of frames at open.
+ * @param nFPS frame rate of the source (0 if unknown)
+ */
+void
+KevDemoFrameSource::restart(double nFPS)
+{
+    m_nSequence = 0;
+    m_nFPS = (nFPS > 0) ? nFPS : 0;
+}
+
+/**
+ * @brief This function returns the timestamp of a frame at the frame rate of the source,
+ *        or at KEV_FRAME_SOURCE_DEFAULT_FPS if unknown.
+ * @param nSequence sequence number of a frame
+ * @return timestamp in nanoseconds
+ */
+int64_t
+KevDemoFrameSource::getNominalTime(uint64_t nSequence)
+{
+    double fps = (m_nFPS > 0) ? m_nFPS : KEV_FRAME_SOURCE_DEFAULT_FPS;
+
+    return (int64_t)(nSequence * 1e9 / fps);
+}
+
+/**
+ * @brief This function returns the time on the monotonic clock, which is the clock of
+ *        the buffer timestamps of the camera drivers on Linux.
+ * @return time in nanoseconds
+ */
+int64_t
+KevDemoFrameSource::getMonotonicTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
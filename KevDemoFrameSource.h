@@ -0,0 +1,96 @@
+#ifndef _KEV_DEMO_FRAME_SOURCE_H_
+#define _KEV_DEMO_FRAME_SOURCE_H_
+
+#include "KevDemoConfig.h"
+
+// frame rate assumed for the timestamps of a source without a clock, e.g. images
+#define KEV_FRAME_SOURCE_DEFAULT_FPS    30
+
+// prefix of a camera device path (e.g. camera:0)
+#define KEV_FRAME_SOURCE_CAMERA_PREFIX  "camera:"
+
+/**
+ * @brief a grayscale frame handed out by a frame source
+ */
+typedef struct KevDemoFrame {
+    // luma plane (CV_8UC1), which may view a buffer of the source until its next read
+    cv::Mat image;
+
+    // capture time in nanoseconds, on the monotonic clock for a camera
+    int64_t timestamp;
+
+    // sequence number counted from zero at open, which skips the frames lost by the source if known
+    uint64_t sequence;
+
+    // region of the image holding the pixels of the frame (empty for the whole image), out
+    // of which the pixels of an earlier frame may be left
+    cv::Rect region;
+} KevDemoFrame_t;
+
+/**
+ * @brief an interface of the sources of the grayscale frames of the VLC decoder
+ *
+ * A source is configured on construction, and opened, read frame by frame and closed
+ * in the same way whether it captures a camera or reads recorded or synthetic frames,
+ * so the same decoding code runs against all of them. Only the luma of a frame is
+ * handed out. When a device or a codec delivers YUV, the Y plane is taken as it is
+ * without color conversion and, for a planar layout, without a copy.
+ *
+ * A source may be asked to crop its frames, e.g. to the ROI blocks of a VLC burst.
+ * A cropped frame keeps the size of the source, so that the pixel coordinates do
+ * not change, but only the pixels of its region are captured or converted.
+ */
+class KevDemoFrameSource
+{
+protected:
+
+    // sequence number of the next frame
+    uint64_t m_nSequence;
+
+    // frame rate of the source (0 if unknown)
+    double m_nFPS;
+
+    // requested crop of the frames (empty for the whole frames)
+    cv::Rect m_rCrop;
+
+public:
+
+    explicit KevDemoFrameSource();
+    virtual ~KevDemoFrameSource();
+
+    // source procedures
+    virtual KevDemoError_t open() = 0;
+    virtual KevDemoError_t readFrame(KevDemoFrame_t& rFrame) = 0;
+    virtual void close() = 0;
+    virtual bool isOpened() = 0;
+
+    // crop of the next frames, if supported by the source
+    virtual bool setCrop(cv::Rect rCrop);
+
+    // accessor
+    inline double getFPS()                      { return m_nFPS;      }
+    inline uint64_t getNumFrames()              { return m_nSequence; }
+
+    // source of a path
+    static KevDemoFrameSource *create(QString rPath);
+
+    // time on the monotonic clock in nanoseconds
+    static int64_t getMonotonicTime();
+
+    // luma of a captured or decoded frame
+    static KevDemoError_t extractLuma(const cv::Mat& rRaw, cv::Size rFrameSize, int nFourCC,
+                                      cv::Mat& rLuma, cv::Mat& rBuffer, cv::Rect *pRegion = nullptr);
+
+    // copy of the region of a frame
+    static void copyRegion(const cv::Mat& rFrame, cv::Rect rRegion, cv::Mat& rBuffer);
+
+protected:
+
+    // start a new sequence of frames
+    void restart(double nFPS);
+
+    // timestamp of a frame at the nominal frame rate
+    int64_t getNominalTime(uint64_t nSequence);
+};
+
+#endif // _KEV_DEMO_FRAME_SOURCE_H_
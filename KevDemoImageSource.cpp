@@ -0,0 +1,112 @@
+#include "KevDemoImageSource.h"
+
+#include <QDir>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoImageSource class
+ * @param rPath a directory of images
+ * @param nFPS frame rate of the timestamps
+ */
+KevDemoImageSource::KevDemoImageSource(QString rPath, double nFPS)
+{
+    m_rPath = rPath;
+    m_nSourceFPS = nFPS;
+}
+
+/**
+ * @brief This is a destructor of KevDemoImageSource class
+ */
+KevDemoImageSource::~KevDemoImageSource()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function lists the image files of the directory.
+ * @return error information
+ */
+KevDemoError_t
+KevDemoImageSource::open()
+{
+    close();
+
+    QStringList filters;
+    filters << "*.png" << "*.bmp" << "*.jpg" << "*.jpeg" << "*.pgm" << "*.tif" << "*.tiff";
+
+    QDir dir(m_rPath);
+
+    for(QString &name : dir.entryList(filters, QDir::Files, QDir::Name))
+    {
+        m_rImageFiles.append(dir.filePath(name));
+    }
+
+    if(m_rImageFiles.isEmpty() == true)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    restart(m_nSourceFPS);
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function decodes the next image into gray.
+ * @param rFrame a read frame, which views the buffer of the source until the next read
+ * @return error information, KEV_ERROR_VLC_END_OF_SOURCE after the last image, or
+ *         KEV_ERROR_VLC_SOURCE_READ if the image cannot be read
+ */
+KevDemoError_t
+KevDemoImageSource::readFrame(KevDemoFrame_t& rFrame)
+{
+    if(m_rImageFiles.isEmpty() == true)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    if(m_nSequence >= (uint64_t)m_rImageFiles.size())
+    {
+        return KEV_ERROR_VLC_END_OF_SOURCE;
+    }
+
+    m_rFrame = cv::imread(m_rImageFiles[(int)m_nSequence].toStdString(), cv::IMREAD_GRAYSCALE);
+
+    if(m_rFrame.empty() == true)
+    {
+        return KEV_ERROR_VLC_SOURCE_READ;
+    }
+
+    rFrame.image = m_rFrame;
+    rFrame.sequence = m_nSequence++;
+    rFrame.timestamp = getNominalTime(rFrame.sequence);
+    rFrame.region = cv::Rect();
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function forgets the image files.
+ */
+void
+KevDemoImageSource::close()
+{
+    m_rImageFiles.clear();
+}
+
+/**
+ * @brief This function returns whether the image files are listed.
+ * @return true if opened, otherwise false
+ */
+bool
+KevDemoImageSource::isOpened()
+{
+    return m_rImageFiles.isEmpty() == false;
+}
@@ -0,0 +1,42 @@
+#ifndef _KEV_DEMO_IMAGE_SOURCE_H_
+#define _KEV_DEMO_IMAGE_SOURCE_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoFrameSource.h"
+
+#include <QStringList>
+
+/**
+ * @brief a frame source of the image files of a directory in name order
+ *
+ * Images are decoded straight into gray, so a gray image is never expanded to BGR and
+ * a JPEG image is decoded from its Y components only. The frames are numbered in name
+ * order and stamped at the nominal frame rate of the source.
+ */
+class KevDemoImageSource : public KevDemoFrameSource
+{
+private:
+
+    // directory and its image files
+    QString m_rPath;
+    QStringList m_rImageFiles;
+
+    // frame rate of the timestamps
+    double m_nSourceFPS;
+
+    // decoded frame
+    cv::Mat m_rFrame;
+
+public:
+
+    explicit KevDemoImageSource(QString rPath, double nFPS = KEV_FRAME_SOURCE_DEFAULT_FPS);
+    virtual ~KevDemoImageSource();
+
+    // source procedures
+    KevDemoError_t open();
+    KevDemoError_t readFrame(KevDemoFrame_t& rFrame);
+    void close();
+    bool isOpened();
+};
+
+#endif // _KEV_DEMO_IMAGE_SOURCE_H_
@@ -0,0 +1,112 @@
+#include "KevDemoLevelTracker.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoLevelTracker class
+ * @param nAlpha weight of a new sample in the running levels
+ */
+KevDemoLevelTracker::KevDemoLevelTracker(float nAlpha)
+{
+    m_nAlpha = nAlpha;
+    clear();
+}
+
+/**
+ * @brief This is a destructor of KevDemoLevelTracker class
+ */
+KevDemoLevelTracker::~KevDemoLevelTracker()
+{
+    clear();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function initializes the levels of each LED with the samples of two
+ *        consecutive sync frames, in which all the LEDs are toggled. If a LED shows
+ *        too little contrast in these frames, both of its levels start from its
+ *        mid level and are separated by the following samples.
+ * @param rMidLevels mid levels of LEDs, e.g. their means over the sync frames
+ * @param rSamples0 samples of LEDs of a sync frame
+ * @param rSamples1 samples of LEDs of the next sync frame
+ */
+void
+KevDemoLevelTracker::train(const std::vector<float>& rMidLevels,
+                           const std::vector<float>& rSamples0, const std::vector<float>& rSamples1)
+{
+    size_t size = rMidLevels.size();
+
+    m_rOnLevels.assign(size, 0);
+    m_rOffLevels.assign(size, 0);
+
+    for(size_t i = 0; i < size; i++)
+    {
+        float high = std::max(rSamples0[i], rSamples1[i]);
+        float low  = std::min(rSamples0[i], rSamples1[i]);
+
+        if(high - low >= KEV_LEVEL_TRACKER_MIN_CONTRAST)
+        {
+            m_rOnLevels[i]  = high;
+            m_rOffLevels[i] = low;
+        }
+        else
+        {
+            m_rOnLevels[i]  = rMidLevels[i];
+            m_rOffLevels[i] = rMidLevels[i];
+        }
+    }
+}
+
+/**
+ * @brief This function decides the states of LEDs against their thresholds, and then
+ *        moves the level of each decided state towards its sample. The soft value of
+ *        a decision is the distance of its sample from the threshold in units of half
+ *        the contrast, so it is +1 at the on level and -1 at the off level.
+ * @param rSamples samples of LEDs of a data frame
+ * @param rDecodedSignals decided states (1 for on, 0 for off)
+ * @param rSoftValues soft values of the decided states, clipped to [-1, 1]
+ */
+void
+KevDemoLevelTracker::decide(const std::vector<float>& rSamples, std::vector<int>& rDecodedSignals,
+                            std::vector<float>& rSoftValues)
+{
+    rDecodedSignals.clear();
+    rSoftValues.clear();
+
+    for(size_t i = 0; i < m_rOnLevels.size(); i++)
+    {
+        float sample = rSamples[i];
+        float margin = std::max((m_rOnLevels[i] - m_rOffLevels[i]) / 2, 1.0f);
+        float softValue = (sample - getThreshold(i)) / margin;
+
+        rSoftValues.push_back(std::min(std::max(softValue, -1.0f), 1.0f));
+
+        if(sample >= getThreshold(i))
+        {
+            m_rOnLevels[i] += m_nAlpha * (sample - m_rOnLevels[i]);
+            rDecodedSignals.push_back(1);
+        }
+        else
+        {
+            m_rOffLevels[i] += m_nAlpha * (sample - m_rOffLevels[i]);
+            rDecodedSignals.push_back(0);
+        }
+    }
+}
+
+/**
+ * @brief This function removes the levels of all LEDs.
+ */
+void
+KevDemoLevelTracker::clear()
+{
+    m_rOnLevels.clear();
+    m_rOffLevels.clear();
+}
@@ -0,0 +1,62 @@
+#ifndef _KEV_DEMO_LEVEL_TRACKER_H_
+#define _KEV_DEMO_LEVEL_TRACKER_H_
+
+#include "KevDemoConfig.h"
+
+// weight of a new sample in the running on & off levels
+#define KEV_LEVEL_TRACKER_ALPHA         0.125f
+
+// minimum difference of the on & off levels of a trained LED
+#define KEV_LEVEL_TRACKER_MIN_CONTRAST  8.0f
+
+/**
+ * @brief a class for deciding the states of LEDs with adaptive thresholds
+ *
+ * Each LED has running estimates of its on and off levels, and a sample is
+ * decided against their midpoint. The level of the decided state is updated
+ * with every sample, so the threshold follows ambient light changes during
+ * the data frames instead of being frozen at the end of the sync frames.
+ */
+class KevDemoLevelTracker
+{
+private:
+
+    // running on & off levels of each LED
+    std::vector<float> m_rOnLevels;
+    std::vector<float> m_rOffLevels;
+
+    // weight of a new sample
+    float m_nAlpha;
+
+public:
+
+    explicit KevDemoLevelTracker(float nAlpha = KEV_LEVEL_TRACKER_ALPHA);
+    virtual ~KevDemoLevelTracker();
+
+    // initialize the levels with two frames of opposite states
+    void train(const std::vector<float>& rMidLevels,
+               const std::vector<float>& rSamples0, const std::vector<float>& rSamples1);
+
+    // decide the states of LEDs and update their levels
+    void decide(const std::vector<float>& rSamples, std::vector<int>& rDecodedSignals,
+                std::vector<float>& rSoftValues);
+
+    void clear();
+
+    // accessor
+    inline size_t getNumLevels()                        { return m_rOnLevels.size();  }
+    inline const std::vector<float>& getOnLevels()      { return m_rOnLevels;         }
+    inline const std::vector<float>& getOffLevels()     { return m_rOffLevels;        }
+
+    /**
+     * @brief This function returns the decision threshold of a LED.
+     * @param nIndex LED index
+     * @return the midpoint of the on & off levels
+     */
+    inline float getThreshold(uint32_t nIndex)
+    {
+        return (m_rOnLevels[nIndex] + m_rOffLevels[nIndex]) / 2;
+    }
+};
+
+#endif // _KEV_DEMO_LEVEL_TRACKER_H_
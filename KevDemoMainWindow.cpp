@@ -48,23 +48,6 @@ KevDemoMainWindow::KevDemoMainWindow(KevDemoEVCharger *pCharger, QWidget *pParen
 
     m_nAuthState = KEV_STATE_AUTH_IDLE;
 
-    //////////////////////////////////////////////////
-    /// camera preview configuration
-    //////////////////////////////////////////////////
-
-    m_pCameraPreview = new KevDemoCameraPreview();
-
-    // Connect the signals and slots for camera preview
-    QObject::connect(m_pCameraPreview, SIGNAL(sig_receiveFrame(cv::Mat)),
-                     this, SLOT(slot_receiveFrame(cv::Mat)));
-
-    // start to display a camera preview
-    if(m_pCameraPreview == nullptr || m_pCameraPreview->open(0) == false)
-    {
-        printLog("Failed to open a camera capture.");
-        return;
-    }
-
     //////////////////////////////////////////////////
     /// VLC decoder configuration (Threshold: 100)
     //////////////////////////////////////////////////
@@ -80,8 +63,7 @@ KevDemoMainWindow::KevDemoMainWindow(KevDemoEVCharger *pCharger, QWidget *pParen
 
     m_nFrameCount = 0;
 
-    m_nVLCDecodedBits = 0;
-    m_nVLCDecodedByte = 0;
+    m_bDummyAuthPending = false;
 
     // VLC decoder signal handling
     QObject::connect(m_pVLCDecoder, SIGNAL(sig_printDebugMessage(QString)),
@@ -97,6 +79,44 @@ KevDemoMainWindow::KevDemoMainWindow(KevDemoEVCharger *pCharger, QWidget *pParen
     QObject::connect(m_pVLCDecoder, SIGNAL(sig_performAuthentication(int)),
                      this, SLOT(slot_authenticationPerformed(int)));
 
+    //////////////////////////////////////////////////
+    /// VLC decoding pipeline configuration
+    //////////////////////////////////////////////////
+
+    m_pVLCPipeline = new KevDemoVLCPipeline(m_pVLCDecoder);
+    m_pVLCPipeline->setDecodeScale(KEV_VLC_DEFAULT_DECODE_SCALE);
+
+    // Display decoded frames and receive decoded bits on the GUI thread
+    QObject::connect(m_pVLCPipeline, SIGNAL(sig_frameReady()),
+                     this, SLOT(slot_displayFrame()));
+    QObject::connect(m_pVLCPipeline, SIGNAL(sig_bitsDecoded()),
+                     this, SLOT(slot_receiveBits()));
+
+    m_pVLCPipeline->open();
+
+    //////////////////////////////////////////////////
+    /// camera preview configuration
+    //////////////////////////////////////////////////
+
+    m_pCameraPreview = new KevDemoCameraPreview();
+
+    // Push captured frames into the pipeline directly on the capture thread
+    QObject::connect(m_pCameraPreview, SIGNAL(sig_receiveFrame(KevDemoFrame_t)),
+                     m_pVLCPipeline, SLOT(slot_pushFrame(KevDemoFrame_t)), Qt::DirectConnection);
+
+    // Crop the captured frames to the ROI blocks while the pipeline receives a burst
+    QObject::connect(m_pVLCPipeline, SIGNAL(sig_requestCrop(QRect)),
+                     m_pCameraPreview, SLOT(slot_setCrop(QRect)), Qt::DirectConnection);
+
+    // start to display a camera preview
+    cv::Size captureSize(KEV_CAMERA_CAPTURE_WIDTH, KEV_CAMERA_CAPTURE_HEIGHT);
+
+    if(m_pCameraPreview == nullptr || m_pCameraPreview->open(0, captureSize) == false)
+    {
+        printLog("Failed to open a camera capture.");
+        return;
+    }
+
     //////////////////////////////////////////////////
     /// VBC reader configuration (Baudrate: 203400)
     //////////////////////////////////////////////////
@@ -289,6 +309,13 @@ KevDemoMainWindow::~KevDemoMainWindow()
         delete m_pCameraPreview;
     }
 
+    // stop the decode stage before releasing the decoder
+    if(m_pVLCPipeline != nullptr)
+    {
+        m_pVLCPipeline->close();
+        delete m_pVLCPipeline;
+    }
+
     if(m_pVLCDecoder != nullptr)
     {
         delete m_pVLCDecoder;
@@ -307,6 +334,50 @@ KevDemoMainWindow::~KevDemoMainWindow()
 // Member Function Definition
 //////////////////////////////////////////////////
 
+/**
+ * @brief This function changes the authentication state, and enables VLC decoding
+ *        only while a car is authenticated or car information is received.
+ * @param nAuthState authentication state
+ */
+void
+KevDemoMainWindow::setAuthState(uint32_t nAuthState)
+{
+    m_nAuthState = nAuthState;
+
+#ifndef KEV_DUMMY_AUTHENTICATE
+    m_pVLCPipeline->setDecodingEnabled(isReceivingVLC());
+#endif
+}
+
+/**
+ * @brief This function returns whether the current state receives a message using VLC.
+ * @return true if a car is being authenticated, otherwise false
+ */
+bool
+KevDemoMainWindow::isReceivingVLC()
+{
+    return m_nAuthState == KEV_STATE_AUTH_CAR || m_nAuthState == KEV_STATE_INFO_CAR;
+}
+
+/**
+ * @brief This function returns the length of the VLC message received in the current state.
+ * @return the number of bits of a message, or 0 if no message is received
+ */
+uint32_t
+KevDemoMainWindow::getVLCMessageBits()
+{
+    if(m_nAuthState == KEV_STATE_AUTH_CAR)
+    {
+        return KEV_VLC_CAR_ID_BITS;
+    }
+    else if(m_nAuthState == KEV_STATE_INFO_CAR)
+    {
+        return KEV_VLC_CAR_INFO_BITS;
+    }
+
+    return 0;
+}
+
 /**
  * @brief This is a funciton to perform a user authentication.
  */
@@ -377,7 +448,7 @@ KevDemoMainWindow::slot_plugInButtonClicked()
 
     // start to authenticate a car using VLC
     printLog("Car authentication starts ...");
-    m_nAuthState = KEV_STATE_AUTH_CAR;
+    setAuthState(KEV_STATE_AUTH_CAR);
 
     // switch to a cam & authentication pane
     m_pUi->sw_main->setCurrentIndex(MAIN_PANE_ID_CAMERA);
@@ -403,9 +474,9 @@ KevDemoMainWindow::slot_vlcDatawidthChanged(QString rString)
 {
     int datawidth = rString.toInt();
 
-    if(m_pVLCDecoder != nullptr)
+    if(m_pVLCPipeline != nullptr)
     {
-        m_pVLCDecoder->setDataWidth(datawidth);
+        m_pVLCPipeline->setDataWidth(datawidth);
     }
 }
 
@@ -418,9 +489,9 @@ KevDemoMainWindow::slot_vlcThresholdChanged(QString rString)
 {
     int threshold = rString.toInt();
 
-    if(m_pVLCDecoder != nullptr)
+    if(m_pVLCPipeline != nullptr)
     {
-        m_pVLCDecoder->setThreshold(threshold);
+        m_pVLCPipeline->setThreshold(threshold);
     }
 }
 
@@ -757,83 +828,112 @@ KevDemoMainWindow::slot_chargingRestartButtonClicked()
 }
 
 /**
- * @brief This is a slot funciton to handle the signal of receiving a frame.
- * @param rPreviewFrame a matrix of camera preview frame
+ * @brief This is a slot funciton to display the latest frame of the decode stage.
  */
 void
-KevDemoMainWindow::slot_receiveFrame(cv::Mat rPreviewFrame)
+KevDemoMainWindow::slot_displayFrame()
 {
-    m_nFrameCount++;
+    if(m_pVLCPipeline->popDisplayFrame(m_rDisplayFrame) == false)
+    {
+        return;
+    }
 
-    cv::Mat frame;
+    m_nFrameCount++;
 
+    // frames are decoded at the capture resolution, and downscaled here only for display
     int w = m_pUi->lb_cam->width();
     int h = m_pUi->lb_cam->height();
 
-#ifndef KEV_DUMMY_AUTHENTICATE
-    int numRecvBits = 0;
-
-    if(m_nAuthState == KEV_STATE_AUTH_CAR)
+    if(w <= 0 || h <= 0)
     {
-        numRecvBits = 8;
+        return;
     }
-    else if(m_nAuthState == KEV_STATE_INFO_CAR)
+
+    cv::resize(m_rDisplayFrame, m_rScaledFrame, cv::Size(w, h), 0, 0, cv::INTER_AREA);
+
+#ifdef KEV_DUMMY_AUTHENTICATE
+    // YOUNGSUN - FOR DEMO
+    if((m_nAuthState == KEV_STATE_AUTH_CAR || m_nAuthState == KEV_STATE_INFO_CAR) &&
+       m_bDummyAuthPending == false)
     {
-        numRecvBits = 16;
+        m_bDummyAuthPending = true;
+        QTimer::singleShot(KEV_DUMMY_AUTH_DELAY_MS, this, SLOT(slot_performDummyAuthentication()));
     }
 #endif
 
-    cv::resize(rPreviewFrame, frame, cv::Size(w, h));
+    // build a image
+    QImage img = QImage((const unsigned char *)m_rScaledFrame.data,
+                        m_rScaledFrame.cols, m_rScaledFrame.rows,
+                        m_rScaledFrame.step, QImage::Format_Indexed8);
+
+    m_pUi->lb_cam->setPixmap(QPixmap::fromImage(img));
+}
 
-    // skip if the current pane is not for camera preview
-    if(m_nAuthState == KEV_STATE_AUTH_CAR || m_nAuthState == KEV_STATE_INFO_CAR)
+/**
+ * @brief This is a slot funciton to handle a batch of bits decoded by the decode stage.
+ *        The decoded bits are split into messages of the length of the current state
+ *        regardless of the frames of the decoder, and the bits left over from the last
+ *        message are carried over to the next batch.
+ */
+void
+KevDemoMainWindow::slot_receiveBits()
+{
+    KevDemoBitStream decodedStream;
+
+    if(m_pVLCPipeline->takeDecodedBits(decodedStream) == false)
     {
-#ifndef KEV_DUMMY_AUTHENTICATE
-        // perform VLC decoding
-        std::vector<int> decodedBits;
+        return;
+    }
 
-        if(m_pVLCDecoder->decode(frame, decodedBits) != KEV_SUCCESS)
-        {
-            return;
-        }
+    if(isReceivingVLC() == false)
+    {
+        m_rVLCStream.clear();
+        return;
+    }
 
-        for(int decodedBit : decodedBits)
-        {
-            m_nVLCDecodedByte = (m_nVLCDecodedByte << 1) | decodedBit;
+    m_rVLCStream.append(decodedStream);
 
-            if(++m_nVLCDecodedBits >= numRecvBits)
-            {
-                QString str("> Decoded bits: ");
-                str.append(QString::number(m_nVLCDecodedByte, 16));
-                printLog(str);
+    while(m_rVLCStream.popBits(getVLCMessageBits(), m_rVLCMessage) == true)
+    {
+        uint32_t numBits = m_rVLCMessage.getNumBits();
 
-                // finish to authenticate a car using VLC
-                slot_authenticationPerformed(m_nVLCDecodedByte);
+        // the bits of a message are its value
+        int value = (int)m_rVLCMessage.readBits(0, numBits);
 
-                m_nVLCDecodedByte = 0;
-                m_nVLCDecodedBits = 0;
-            }
-        }
-#else
-        // YOUNGSUN - FOR DEMO
-        if(m_nAuthState == KEV_STATE_AUTH_CAR)
-        {
-            slot_authenticationPerformed(0xA2);
-        }
-        else if(m_nAuthState == KEV_STATE_INFO_CAR)
+        QString str("> Decoded bits: ");
+        str.append(QString::number(value, 16));
+        str.append(QString(" (%1 bits)").arg(numBits));
+        printLog(str);
+
+        // finish to authenticate a car using VLC
+        slot_authenticationPerformed(value);
+
+        // the following messages of the same batch may not be received in the new state
+        if(isReceivingVLC() == false)
         {
-            slot_authenticationPerformed((246 << 8) | 78);
+            m_rVLCStream.clear();
+            break;
         }
-
-        QThread::sleep(1);
-#endif
     }
+}
 
-    // build a image
-    QImage img = QImage((const unsigned char *)frame.data,
-                        frame.cols, frame.rows, QImage::Format_Indexed8);
+/**
+ * @brief This is a slot function to authenticate with dummy information, which
+ *        replaces VLC decoding for demo.
+ */
+void
+KevDemoMainWindow::slot_performDummyAuthentication()
+{
+    m_bDummyAuthPending = false;
 
-    m_pUi->lb_cam->setPixmap(QPixmap::fromImage(img));
+    if(m_nAuthState == KEV_STATE_AUTH_CAR)
+    {
+        slot_authenticationPerformed(0xA2);
+    }
+    else if(m_nAuthState == KEV_STATE_INFO_CAR)
+    {
+        slot_authenticationPerformed((246 << 8) | 78);
+    }
 }
 
 /**
@@ -866,7 +966,7 @@ KevDemoMainWindow::slot_authenticationPerformed(int nAuthInfo)
             m_pCharger->setEVehicle(m_pVehicle);
 
             // start to user authentication using VBC
-            m_nAuthState = KEV_STATE_AUTH_USER;
+            setAuthState(KEV_STATE_AUTH_USER);
             performUserAuthentication();
 
             break;
@@ -888,7 +988,7 @@ KevDemoMainWindow::slot_authenticationPerformed(int nAuthInfo)
             }
 
             // switch to a cam pane to receive car information
-            m_nAuthState = KEV_STATE_INFO_CAR;
+            setAuthState(KEV_STATE_INFO_CAR);
             m_pUi->sw_main->setCurrentIndex(MAIN_PANE_ID_CAMERA);
 
             break;
@@ -896,7 +996,7 @@ KevDemoMainWindow::slot_authenticationPerformed(int nAuthInfo)
         case KEV_STATE_INFO_CAR:
         {
             printLog("Car information received.");
-            m_nAuthState = KEV_STATE_AUTH_IDLE;
+            setAuthState(KEV_STATE_AUTH_IDLE);
 
             double chargingAmount   = (nAuthInfo & 0x00FF);
             double chargingCapacity = (nAuthInfo & 0xFF00) >> 8;
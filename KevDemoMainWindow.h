@@ -4,6 +4,7 @@
 #include "KevDemoConfig.h"
 #include "KevDemoDatabase.h"
 #include "KevDemoVLCDecoder.h"
+#include "KevDemoVLCPipeline.h"
 #include "KevDemoVBCReader.h"
 #include "KevDemoCameraPreview.h"
 #include "KevDemoEVCharger.h"
@@ -30,6 +31,17 @@
 #define KEV_STATE_AUTH_USER (KEV_STATE_AUTH_CAR+1)
 #define KEV_STATE_INFO_CAR  (KEV_STATE_AUTH_USER+1)
 
+// length of the VLC messages of a car ID and car information in bits
+#define KEV_VLC_CAR_ID_BITS     8
+#define KEV_VLC_CAR_INFO_BITS   16
+
+// camera capture resolution for VLC decoding (0 for the camera default)
+#define KEV_CAMERA_CAPTURE_WIDTH    0
+#define KEV_CAMERA_CAPTURE_HEIGHT   0
+
+// delay of a dummy authentication in milliseconds
+#define KEV_DUMMY_AUTH_DELAY_MS 1000
+
 // keypad
 #define KEY_KEYPAD_DEL 10
 #define KEY_KEYPAD_CLR 11
@@ -52,9 +64,20 @@ private:
 
     // VLC decoder
     KevDemoVLCDecoder *m_pVLCDecoder;
-    uint32_t m_nVLCRequiredBits;
-    uint32_t m_nVLCDecodedBits;
-    uint32_t m_nVLCDecodedByte;
+
+    // decoded bits being received, and the last received message
+    KevDemoBitStream m_rVLCStream;
+    KevDemoBitStream m_rVLCMessage;
+
+    // VLC decoding pipeline
+    KevDemoVLCPipeline *m_pVLCPipeline;
+
+    // camera preview frame of the display stage and its downscaled frame
+    cv::Mat m_rDisplayFrame;
+    cv::Mat m_rScaledFrame;
+
+    // dummy authentication flag
+    bool m_bDummyAuthPending;
 
     // VBC reader
     KevDemoVBCReader *m_pVBCReader;
@@ -125,14 +148,27 @@ public slots:
     void slot_chargingStopButtonClicked();
     void slot_chargingPayButtonClicked();
 
-    // Slots for a camera preview
-    void slot_receiveFrame(cv::Mat rPreviewFrame);
+    // Slots for the display stage of VLC decoding pipeline
+    void slot_displayFrame();
+    void slot_receiveBits();
+
+    // Slots for a dummy authentication
+    void slot_performDummyAuthentication();
 
     // Slots for pring a message
     void slot_printDebugMessage(const QString rString);
 
 private:
 
+    // change the authentication state
+    void setAuthState(uint32_t nAuthState);
+
+    // whether the current state receives a message using VLC
+    bool isReceivingVLC();
+
+    // length of the VLC message received in the current state
+    uint32_t getVLCMessageBits();
+
     // perform user authentication using VBC
     void performUserAuthentication();
 
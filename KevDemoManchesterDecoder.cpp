@@ -0,0 +1,181 @@
+#include "KevDemoManchesterDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoManchesterDecoder class
+ */
+KevDemoManchesterDecoder::KevDemoManchesterDecoder()
+{
+    reset(std::vector<uint32_t>());
+}
+
+/**
+ * @brief This is a destructor of KevDemoManchesterDecoder class
+ */
+KevDemoManchesterDecoder::~KevDemoManchesterDecoder()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function discards the accumulated symbol, and keeps the ROI sums of the
+ *        last sync frame as the previous frame of the first data frame.
+ * @param rSums pixel sums of ROI blocks of the last sync frame
+ */
+void
+KevDemoManchesterDecoder::reset(const std::vector<uint32_t>& rSums)
+{
+    m_rPrevSums = rSums;
+    m_rDeltas.assign(rSums.size(), 0);
+    m_rCorrelations.assign(rSums.size(), 0);
+    m_nWeight = 0;
+    m_nEnergy = 0;
+}
+
+/**
+ * @brief This function obtains the deltas of LEDs from the ROI sums of the previous and
+ *        current frames, and keeps the current sums for the next frame.
+ * @param rSums pixel sums of ROI blocks of the current frame
+ * @param rAreas the number of pixels of ROI blocks
+ * @param rLevelTracker on & off levels of the LEDs
+ */
+void
+KevDemoManchesterDecoder::update(const std::vector<uint32_t>& rSums, const std::vector<uint32_t>& rAreas,
+                                 KevDemoLevelTracker& rLevelTracker)
+{
+    size_t size = rSums.size();
+
+    // the first frame after a layout change has no transitions
+    if(m_rPrevSums.size() != size || rAreas.size() != size || rLevelTracker.getNumLevels() != size)
+    {
+        reset(rSums);
+        return;
+    }
+
+    const std::vector<float> &onLevels = rLevelTracker.getOnLevels();
+    const std::vector<float> &offLevels = rLevelTracker.getOffLevels();
+
+    for(size_t i = 0; i < size; i++)
+    {
+        float delta = ((int64_t)rSums[i] - (int64_t)m_rPrevSums[i]) / (float)rAreas[i];
+        float contrast = std::max(onLevels[i] - offLevels[i], KEV_LEVEL_TRACKER_MIN_CONTRAST);
+
+        m_rDeltas[i] = delta / contrast;
+    }
+
+    m_rPrevSums = rSums;
+}
+
+/**
+ * @brief This function classifies the transitions of LEDs of the current frame.
+ * @param rDecodedSignals KEV_VLC_MANCH_HOLDING, KEV_VLC_MANCH_FALLING or KEV_VLC_MANCH_RISING
+ * @param rSoftValues soft values of the bits carried by falling LEDs, clipped to [-1, 1]
+ */
+void
+KevDemoManchesterDecoder::classify(std::vector<int>& rDecodedSignals, std::vector<float>& rSoftValues)
+{
+    rDecodedSignals.clear();
+    rSoftValues.clear();
+
+    for(float delta : m_rDeltas)
+    {
+        if(delta <= -KEV_MANCHESTER_MIN_DELTA)
+        {
+            rDecodedSignals.push_back(KEV_VLC_MANCH_FALLING);
+        }
+        else if(delta >= KEV_MANCHESTER_MIN_DELTA)
+        {
+            rDecodedSignals.push_back(KEV_VLC_MANCH_RISING);
+        }
+        else
+        {
+            rDecodedSignals.push_back(KEV_VLC_MANCH_HOLDING);
+        }
+
+        rSoftValues.push_back(std::min(std::max(-delta, -1.0f), 1.0f));
+    }
+}
+
+/**
+ * @brief This function accumulates the data deltas of the current frame weighted by the
+ *        falling clock LED, and appends the bits of a symbol once its mid-symbol
+ *        transition is over.
+ * @param nClockIndex index of the clock LED
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoManchesterDecoder::push(uint32_t nClockIndex, KevDemoBitStream& rBitStream)
+{
+    if(nClockIndex >= m_rDeltas.size())
+    {
+        return;
+    }
+
+    // the part of the mid-symbol transition observed in this frame
+    float weight = -m_rDeltas[nClockIndex];
+
+    if(weight <= 0)
+    {
+        flush(nClockIndex, rBitStream);
+        return;
+    }
+
+    for(size_t i = 0; i < m_rDeltas.size(); i++)
+    {
+        m_rCorrelations[i] -= weight * m_rDeltas[i];
+    }
+
+    m_nWeight += weight;
+    m_nEnergy += weight * weight;
+}
+
+/**
+ * @brief This function appends the bits of the accumulated symbol, if its mid-symbol
+ *        transition is observed enough, and starts a new symbol.
+ * @param nClockIndex index of the clock LED
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoManchesterDecoder::flush(uint32_t nClockIndex, KevDemoBitStream& rBitStream)
+{
+    if(m_nWeight >= KEV_MANCHESTER_MIN_WEIGHT)
+    {
+        emitSymbol(nClockIndex, rBitStream);
+    }
+
+    std::fill(m_rCorrelations.begin(), m_rCorrelations.end(), 0);
+    m_nWeight = 0;
+    m_nEnergy = 0;
+}
+
+/**
+ * @brief This function decides the bits of data LEDs by the signs of their correlations
+ *        with the falling clock LED, with the normalized correlations as confidences.
+ * @param nClockIndex index of the clock LED
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoManchesterDecoder::emitSymbol(uint32_t nClockIndex, KevDemoBitStream& rBitStream)
+{
+    for(uint32_t i = 0; i < m_rCorrelations.size(); i++)
+    {
+        if(i == nClockIndex)
+        {
+            continue;
+        }
+
+        float softValue = std::min(std::abs(m_rCorrelations[i]) / m_nEnergy, 1.0f);
+
+        rBitStream.append((m_rCorrelations[i] >= 0) ? 1 : 0,
+                          (uint8_t)(softValue * KEV_BIT_STREAM_MAX_CONFIDENCE));
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef _KEV_DEMO_MANCHESTER_DECODER_H_
+#define _KEV_DEMO_MANCHESTER_DECODER_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoBitStream.h"
+#include "KevDemoLevelTracker.h"
+
+// transitions of a LED between two frames
+#define KEV_VLC_MANCH_HOLDING     0
+#define KEV_VLC_MANCH_FALLING     1
+#define KEV_VLC_MANCH_RISING      2
+
+// minimum delta of a transition in units of the contrast of a LED
+#define KEV_MANCHESTER_MIN_DELTA    0.5f
+
+// minimum part of a mid-symbol clock transition observed to decide a symbol
+#define KEV_MANCHESTER_MIN_WEIGHT   0.25f
+
+/**
+ * @brief a class for decoding Manchester-coded symbols from the transitions of LEDs
+ *
+ * A data LED shows its bit in the first half of a symbol, while the clock LED is on,
+ * and the inverted bit in the second half, so every data LED switches when the clock
+ * LED falls in the middle of a symbol: a falling LED carries 1 and a rising LED 0.
+ * The transitions are the signed differences of the ROI sums of consecutive frames,
+ * which do not depend on slowly changing ambient light. A mid-symbol transition
+ * blended over two frames is recovered by weighting the deltas of data LEDs by the
+ * falling part of the clock LED in each frame, and the symbol is decided once the
+ * clock LED stops falling. Transitions at symbol boundaries come with a rising clock
+ * LED, and are not weighted.
+ */
+class KevDemoManchesterDecoder
+{
+private:
+
+    // pixel sums of ROI blocks of the previous frame
+    std::vector<uint32_t> m_rPrevSums;
+
+    // deltas of LEDs of the current frame in units of their contrasts
+    std::vector<float> m_rDeltas;
+
+    // correlations of data deltas with the falling clock, and the sum and the energy
+    // of the falling clock over the mid-symbol transition
+    std::vector<float> m_rCorrelations;
+    float m_nWeight;
+    float m_nEnergy;
+
+public:
+
+    explicit KevDemoManchesterDecoder();
+    virtual ~KevDemoManchesterDecoder();
+
+    // start from the ROI sums of the last sync frame
+    void reset(const std::vector<uint32_t>& rSums);
+
+    // decoding procedures
+    void update(const std::vector<uint32_t>& rSums, const std::vector<uint32_t>& rAreas,
+                KevDemoLevelTracker& rLevelTracker);
+    void classify(std::vector<int>& rDecodedSignals, std::vector<float>& rSoftValues);
+    void push(uint32_t nClockIndex, KevDemoBitStream& rBitStream);
+    void flush(uint32_t nClockIndex, KevDemoBitStream& rBitStream);
+
+    // accessor
+    inline const std::vector<float>& getDeltas()    { return m_rDeltas; }
+
+private:
+
+    // decide and append the bits of the accumulated symbol
+    void emitSymbol(uint32_t nClockIndex, KevDemoBitStream& rBitStream);
+};
+
+#endif // _KEV_DEMO_MANCHESTER_DECODER_H_
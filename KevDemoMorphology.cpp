@@ -0,0 +1,284 @@
+#include "KevDemoMorphology.h"
+
+#include <algorithm>
+#include <cstring>
+#include <opencv2/core/hal/intrin.hpp>
+
+/**
+ * @brief running maximum for dilation, ignoring pixels outside the frame
+ */
+struct KevDemoMaxOp
+{
+    enum { border = 0 };
+
+    static inline uint8_t apply(uint8_t a, uint8_t b)   { return std::max(a, b); }
+#if CV_SIMD128
+    static inline cv::v_uint8x16 apply(const cv::v_uint8x16& a, const cv::v_uint8x16& b)
+    {
+        return cv::v_max(a, b);
+    }
+#endif
+};
+
+/**
+ * @brief running minimum for erosion, ignoring pixels outside the frame
+ */
+struct KevDemoMinOp
+{
+    enum { border = 255 };
+
+    static inline uint8_t apply(uint8_t a, uint8_t b)   { return std::min(a, b); }
+#if CV_SIMD128
+    static inline cv::v_uint8x16 apply(const cv::v_uint8x16& a, const cv::v_uint8x16& b)
+    {
+        return cv::v_min(a, b);
+    }
+#endif
+};
+
+/**
+ * @brief This function combines two rows element-wise.
+ * @param pRow0 a row
+ * @param pRow1 another row
+ * @param pDstRow result row
+ * @param nCols the number of bytes of a row
+ */
+template<typename Op>
+static inline void
+combineRows(const uint8_t *pRow0, const uint8_t *pRow1, uint8_t *pDstRow, int nCols)
+{
+    int x = 0;
+
+#if CV_SIMD128
+    for(; x <= nCols - 16; x += 16)
+    {
+        cv::v_store(pDstRow + x, Op::apply(cv::v_load(pRow0 + x), cv::v_load(pRow1 + x)));
+    }
+#endif
+    for(; x < nCols; x++)
+    {
+        pDstRow[x] = Op::apply(pRow0[x], pRow1[x]);
+    }
+}
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoMorphology class
+ */
+KevDemoMorphology::KevDemoMorphology()
+{
+}
+
+/**
+ * @brief This is a destructor of KevDemoMorphology class
+ */
+KevDemoMorphology::~KevDemoMorphology()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function dilates the given frame twice and then erodes it with
+ *        a square filter of the given size, in place. The two dilations are
+ *        fused into a single dilation with a filter of (2 * nFilterSize - 1).
+ * @param rFrame a B&W frame (CV_8UC1) to be filtered
+ * @param nFilterSize filter size
+ * @return error information
+ */
+KevDemoError_t
+KevDemoMorphology::filter(cv::Mat& rFrame, int nFilterSize)
+{
+    if(rFrame.empty() == true || rFrame.type() != CV_8UC1 || nFilterSize <= 0)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    int before = nFilterSize / 2;
+    int after = nFilterSize - 1 - before;
+
+    filterRows<KevDemoMaxOp>(rFrame, 2 * before, 2 * after);
+    filterColumns<KevDemoMaxOp>(rFrame, 2 * before, 2 * after);
+
+    filterRows<KevDemoMinOp>(rFrame, before, after);
+    filterColumns<KevDemoMinOp>(rFrame, before, after);
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function dilates the given frame with a rectangular filter, in place.
+ * @param rFrame a B&W frame (CV_8UC1) to be dilated
+ * @param rFilterSize filter size
+ * @return error information
+ */
+KevDemoError_t
+KevDemoMorphology::dilate(cv::Mat& rFrame, cv::Size rFilterSize)
+{
+    if(rFrame.empty() == true || rFrame.type() != CV_8UC1 || rFilterSize.area() <= 0)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    filterRows<KevDemoMaxOp>(rFrame, rFilterSize.width / 2, (rFilterSize.width - 1) / 2);
+    filterColumns<KevDemoMaxOp>(rFrame, rFilterSize.height / 2, (rFilterSize.height - 1) / 2);
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function erodes the given frame with a rectangular filter, in place.
+ * @param rFrame a B&W frame (CV_8UC1) to be eroded
+ * @param rFilterSize filter size
+ * @return error information
+ */
+KevDemoError_t
+KevDemoMorphology::erode(cv::Mat& rFrame, cv::Size rFilterSize)
+{
+    if(rFrame.empty() == true || rFrame.type() != CV_8UC1 || rFilterSize.area() <= 0)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    filterRows<KevDemoMinOp>(rFrame, rFilterSize.width / 2, (rFilterSize.width - 1) / 2);
+    filterColumns<KevDemoMinOp>(rFrame, rFilterSize.height / 2, (rFilterSize.height - 1) / 2);
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function replaces each pixel with the extremum of the pixels from
+ *        nLeft pixels on its left to nRight pixels on its right, in place.
+ *
+ * The padded row is split into blocks of the window size. The forward extrema
+ * restart at the beginning of each block and the backward extrema at its end,
+ * so a window spanning two blocks is the backward extremum of its first pixel
+ * combined with the forward extremum of its last pixel.
+ *
+ * @param rFrame a frame (CV_8UC1)
+ * @param nLeft the number of pixels on the left of the window
+ * @param nRight the number of pixels on the right of the window
+ */
+template<typename Op>
+void
+KevDemoMorphology::filterRows(cv::Mat& rFrame, int nLeft, int nRight)
+{
+    int window = nLeft + nRight + 1;
+
+    if(window == 1)
+    {
+        return;
+    }
+
+    int cols = rFrame.cols;
+    int length = cols + window - 1;
+
+    m_rPaddedRow.resize(length);
+    m_rForwardRow.resize(length);
+    m_rBackwardRow.resize(length);
+
+    uint8_t *padded = m_rPaddedRow.data();
+    uint8_t *forward = m_rForwardRow.data();
+    uint8_t *backward = m_rBackwardRow.data();
+
+    std::fill(padded, padded + nLeft, Op::border);
+    std::fill(padded + nLeft + cols, padded + length, Op::border);
+
+    for(int y = 0; y < rFrame.rows; y++)
+    {
+        uint8_t *row = rFrame.ptr<uint8_t>(y);
+        memcpy(padded + nLeft, row, cols);
+
+        for(int start = 0; start < length; start += window)
+        {
+            int end = std::min(start + window, length) - 1;
+
+            forward[start] = padded[start];
+            for(int x = start + 1; x <= end; x++)
+            {
+                forward[x] = Op::apply(forward[x - 1], padded[x]);
+            }
+
+            backward[end] = padded[end];
+            for(int x = end - 1; x >= start; x--)
+            {
+                backward[x] = Op::apply(backward[x + 1], padded[x]);
+            }
+        }
+
+        for(int x = 0; x < cols; x++)
+        {
+            row[x] = Op::apply(backward[x], forward[x + window - 1]);
+        }
+    }
+}
+
+/**
+ * @brief This function replaces each pixel with the extremum of the pixels from
+ *        nTop pixels above it to nBottom pixels below it, in place. The running
+ *        extrema of filterRows() are computed over whole rows at once.
+ * @param rFrame a frame (CV_8UC1)
+ * @param nTop the number of pixels above the window
+ * @param nBottom the number of pixels below the window
+ */
+template<typename Op>
+void
+KevDemoMorphology::filterColumns(cv::Mat& rFrame, int nTop, int nBottom)
+{
+    int window = nTop + nBottom + 1;
+
+    if(window == 1)
+    {
+        return;
+    }
+
+    int rows = rFrame.rows;
+    int cols = rFrame.cols;
+    int length = rows + window - 1;
+
+    // the buffers are only grown, as the windows of a dilation and an erosion differ
+    if(m_rForwardRows.rows < length || m_rForwardRows.cols != cols)
+    {
+        m_rForwardRows.create(length, cols, CV_8UC1);
+        m_rBackwardRows.create(length, cols, CV_8UC1);
+    }
+
+    m_rBorderRow.assign(cols, Op::border);
+
+    // rows of the padded frame
+    auto paddedRow = [&](int y) -> const uint8_t *
+    {
+        y -= nTop;
+        return (y >= 0 && y < rows) ? rFrame.ptr<uint8_t>(y) : m_rBorderRow.data();
+    };
+
+    for(int start = 0; start < length; start += window)
+    {
+        int end = std::min(start + window, length) - 1;
+
+        memcpy(m_rForwardRows.ptr<uint8_t>(start), paddedRow(start), cols);
+        for(int y = start + 1; y <= end; y++)
+        {
+            combineRows<Op>(m_rForwardRows.ptr<uint8_t>(y - 1), paddedRow(y),
+                            m_rForwardRows.ptr<uint8_t>(y), cols);
+        }
+
+        memcpy(m_rBackwardRows.ptr<uint8_t>(end), paddedRow(end), cols);
+        for(int y = end - 1; y >= start; y--)
+        {
+            combineRows<Op>(m_rBackwardRows.ptr<uint8_t>(y + 1), paddedRow(y),
+                            m_rBackwardRows.ptr<uint8_t>(y), cols);
+        }
+    }
+
+    for(int y = 0; y < rows; y++)
+    {
+        combineRows<Op>(m_rBackwardRows.ptr<uint8_t>(y), m_rForwardRows.ptr<uint8_t>(y + window - 1),
+                        rFrame.ptr<uint8_t>(y), cols);
+    }
+}
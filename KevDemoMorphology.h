@@ -0,0 +1,53 @@
+#ifndef _KEV_DEMO_MORPHOLOGY_H_
+#define _KEV_DEMO_MORPHOLOGY_H_
+
+#include "KevDemoConfig.h"
+
+/**
+ * @brief a class for morphological filtering of B&W frames with rectangular filters
+ *
+ * A rectangular filter is separable, so each dilation or erosion is performed as
+ * a horizontal and a vertical running maximum or minimum. The running extrema are
+ * computed by the van Herk/Gil-Werman algorithm, which takes three comparisons per
+ * pixel regardless of the filter size. The vertical pass combines whole rows, so
+ * that it is vectorized over the bytes of a row.
+ *
+ * Pixels outside the frame are ignored like the default border of cv::dilate and
+ * cv::erode, and the anchor is at the center of the filter.
+ */
+class KevDemoMorphology
+{
+private:
+
+    // forward and backward running extrema of the vertical pass
+    cv::Mat m_rForwardRows;
+    cv::Mat m_rBackwardRows;
+
+    // padded row and its forward and backward running extrema of the horizontal pass
+    std::vector<uint8_t> m_rPaddedRow;
+    std::vector<uint8_t> m_rForwardRow;
+    std::vector<uint8_t> m_rBackwardRow;
+
+    // constant rows outside the frame for the vertical pass
+    std::vector<uint8_t> m_rBorderRow;
+
+public:
+
+    explicit KevDemoMorphology();
+    virtual ~KevDemoMorphology();
+
+    // dilate twice and then erode with a rectangular filter
+    KevDemoError_t filter(cv::Mat& rFrame, int nFilterSize);
+
+    // single operations with a rectangular filter
+    KevDemoError_t dilate(cv::Mat& rFrame, cv::Size rFilterSize);
+    KevDemoError_t erode(cv::Mat& rFrame, cv::Size rFilterSize);
+
+private:
+
+    // running extrema over the given window of each row and column
+    template<typename Op> void filterRows(cv::Mat& rFrame, int nLeft, int nRight);
+    template<typename Op> void filterColumns(cv::Mat& rFrame, int nTop, int nBottom);
+};
+
+#endif // _KEV_DEMO_MORPHOLOGY_H_
@@ -25,3 +25,20 @@ KevDemoROIBlock::isOverlap(KevDemoROIBlock rBlock)
 
     return false;
 }
+
+/**
+ * @brief This function moves this ROI by the given offset.
+ * @param rOffset an offset in pixels
+ */
+void
+KevDemoROIBlock::translate(cv::Point rOffset)
+{
+    m_rBoundingRect.x += rOffset.x;
+    m_rBoundingRect.y += rOffset.y;
+
+    for(cv::Point &point : m_rContour)
+    {
+        point.x += rOffset.x;
+        point.y += rOffset.y;
+    }
+}
@@ -24,6 +24,7 @@ public:
 
     // member functions
     bool isOverlap(KevDemoROIBlock rBlock);
+    void translate(cv::Point rOffset);
 
 private:
     // bounding rectangule
@@ -0,0 +1,157 @@
+#include "KevDemoROISampler.h"
+
+#include <algorithm>
+#include <opencv2/core/hal/intrin.hpp>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoROISampler class
+ */
+KevDemoROISampler::KevDemoROISampler()
+{
+    clear();
+}
+
+/**
+ * @brief This is a destructor of KevDemoROISampler class
+ */
+KevDemoROISampler::~KevDemoROISampler()
+{
+    clear();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function builds a list of row spans of the given ROI blocks.
+ * @param rROIBlocks ROI blocks to be sampled
+ */
+void
+KevDemoROISampler::configure(std::vector<KevDemoROIBlock>& rROIBlocks)
+{
+    clear();
+
+    int index = 0;
+
+    for(KevDemoROIBlock &block : rROIBlocks)
+    {
+        cv::Rect rect = block.getBoundingRect();
+
+        for(int y = rect.y; y < rect.y + rect.height; y++)
+        {
+            m_rSpans.push_back({y, rect.x, rect.width, index});
+        }
+
+        m_rUnionRect = (index == 0) ? rect : (m_rUnionRect | rect);
+        m_rAreas.push_back(rect.area());
+        index++;
+    }
+
+    // visit the rows from top to bottom, and the spans of a row from left to right
+    std::sort(m_rSpans.begin(), m_rSpans.end(), [](const ROISpan_t& a, const ROISpan_t& b) {
+        return (a.row != b.row) ? (a.row < b.row) : (a.start < b.start);
+    });
+
+    m_rSums.assign(m_rAreas.size(), 0);
+}
+
+/**
+ * @brief This function removes all the ROI spans.
+ */
+void
+KevDemoROISampler::clear()
+{
+    m_rSpans.clear();
+    m_rAreas.clear();
+    m_rSums.clear();
+    m_rUnionRect = cv::Rect();
+}
+
+/**
+ * @brief This function sums up the pixels of all ROI blocks in a single pass over
+ *        the ROI rows of a frame and returns the mean of each ROI block.
+ * @param rFrame an image frame (CV_8UC1)
+ * @param rMeans the means of ROI blocks in the configured order
+ * @return error information
+ */
+KevDemoError_t
+KevDemoROISampler::sample(const cv::Mat& rFrame, std::vector<float>& rMeans)
+{
+    if(rFrame.empty() == true || rFrame.type() != CV_8UC1)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    // all the ROI blocks must lie inside the frame
+    if((m_rUnionRect & cv::Rect(0, 0, rFrame.cols, rFrame.rows)) != m_rUnionRect)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    std::fill(m_rSums.begin(), m_rSums.end(), 0);
+
+    const uint8_t *rowData = nullptr;
+    int row = -1;
+
+    for(ROISpan_t &span : m_rSpans)
+    {
+        if(span.row != row)
+        {
+            row = span.row;
+            rowData = rFrame.ptr<uint8_t>(row);
+        }
+
+        m_rSums[span.index] += sumSpan(rowData + span.start, span.width);
+    }
+
+    rMeans.resize(m_rSums.size());
+
+    for(size_t i = 0; i < m_rSums.size(); i++)
+    {
+        rMeans[i] = (float)m_rSums[i] / (float)m_rAreas[i];
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function returns the sum of the given pixels.
+ * @param pData pixels of a span
+ * @param nWidth the number of pixels
+ * @return the sum of pixels
+ */
+uint32_t
+KevDemoROISampler::sumSpan(const uint8_t *pData, int nWidth)
+{
+    uint32_t sum = 0;
+    int x = 0;
+
+#if CV_SIMD128
+    cv::v_uint32x4 vSum = cv::v_setzero_u32();
+
+    for(; x <= nWidth - 16; x += 16)
+    {
+        cv::v_uint16x8 lo, hi;
+        cv::v_uint32x4 lo32, hi32;
+
+        // 16 pixels into 8 lanes (max. 2 * 255), and then into 4 lanes
+        cv::v_expand(cv::v_load(pData + x), lo, hi);
+        cv::v_expand(lo + hi, lo32, hi32);
+
+        vSum = vSum + lo32 + hi32;
+    }
+
+    sum = cv::v_reduce_sum(vSum);
+#endif
+    for(; x < nWidth; x++)
+    {
+        sum += pData[x];
+    }
+
+    return sum;
+}
@@ -0,0 +1,62 @@
+#ifndef _KEV_DEMO_ROI_SAMPLER_H_
+#define _KEV_DEMO_ROI_SAMPLER_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoROIBlock.h"
+
+/**
+ * @brief a class for sampling the pixel sums of many ROI blocks in a single pass
+ *
+ * ROI blocks are broken into horizontal spans, which are sorted by row so that
+ * a frame is scanned once from top to bottom over the union of the ROI rows
+ * instead of walking each ROI rectangle separately.
+ */
+class KevDemoROISampler
+{
+private:
+
+    /**
+     * @brief a horizontal span of an ROI block on a single row
+     */
+    typedef struct ROISpan {
+        int row;
+        int start;
+        int width;
+        int index;
+    } ROISpan_t;
+
+    // spans of all ROI blocks sorted by row
+    std::vector<ROISpan_t> m_rSpans;
+
+    // bounding rectangle of all ROI blocks
+    cv::Rect m_rUnionRect;
+
+    // number of pixels of each ROI block
+    std::vector<uint32_t> m_rAreas;
+
+    // pixel sums of each ROI block of the last sampled frame
+    std::vector<uint32_t> m_rSums;
+
+public:
+
+    explicit KevDemoROISampler();
+    virtual ~KevDemoROISampler();
+
+    // build spans of the given ROI blocks
+    void configure(std::vector<KevDemoROIBlock>& rROIBlocks);
+    void clear();
+
+    // sample the means of ROI blocks of a frame
+    KevDemoError_t sample(const cv::Mat& rFrame, std::vector<float>& rMeans);
+
+    // accessor
+    inline size_t getNumROIs()                      { return m_rAreas.size(); }
+    inline cv::Rect getUnionRect()                  { return m_rUnionRect;    }
+    inline const std::vector<uint32_t>& getSums()   { return m_rSums;         }
+    inline const std::vector<uint32_t>& getAreas()  { return m_rAreas;        }
+
+    // sum the pixels of a span
+    static uint32_t sumSpan(const uint8_t *pData, int nWidth);
+};
+
+#endif // _KEV_DEMO_ROI_SAMPLER_H_
@@ -0,0 +1,167 @@
+#include "KevDemoROITracker.h"
+
+#include <cmath>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoROITracker class
+ */
+KevDemoROITracker::KevDemoROITracker()
+{
+    clear();
+}
+
+/**
+ * @brief This is a destructor of KevDemoROITracker class
+ */
+KevDemoROITracker::~KevDemoROITracker()
+{
+    clear();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function forgets the reference centroids to track newly locked ROI blocks.
+ * @param nNumROIs the number of ROI blocks
+ */
+void
+KevDemoROITracker::configure(size_t nNumROIs)
+{
+    m_rReferences.assign(nNumROIs, cv::Point2f());
+    m_rHasReferences.assign(nNumROIs, false);
+    m_rOffsets.assign(nNumROIs, cv::Point());
+}
+
+/**
+ * @brief This function removes all the tracked ROI blocks.
+ */
+void
+KevDemoROITracker::clear()
+{
+    m_rReferences.clear();
+    m_rHasReferences.clear();
+    m_rOffsets.clear();
+}
+
+/**
+ * @brief This function locates the LEDs decided on in a frame and moves their ROI blocks
+ *        in place if the LEDs have drifted.
+ * @param rFrame a data frame (CV_8UC1)
+ * @param rROIBlocks ROI blocks of the LEDs
+ * @param rSoftValues soft values of the LEDs decided in the frame
+ * @param rLevelTracker on & off levels of the LEDs
+ * @return true if any ROI block is moved, otherwise false.
+ */
+bool
+KevDemoROITracker::track(const cv::Mat& rFrame, std::vector<KevDemoROIBlock>& rROIBlocks,
+                         const std::vector<float>& rSoftValues, KevDemoLevelTracker& rLevelTracker)
+{
+    if(rFrame.type() != CV_8UC1 || rROIBlocks.size() != m_rReferences.size() ||
+       rSoftValues.size() != rROIBlocks.size() || rLevelTracker.getNumLevels() != rROIBlocks.size())
+    {
+        return false;
+    }
+
+    cv::Rect frameRect(0, 0, rFrame.cols, rFrame.rows);
+    bool isMoved = false;
+
+    for(uint32_t i = 0; i < rROIBlocks.size(); i++)
+    {
+        // only a bright LED can be told from its surroundings
+        if(rSoftValues[i] < KEV_ROI_TRACKER_MIN_SOFT)
+        {
+            continue;
+        }
+
+        cv::Rect rect = rROIBlocks[i].getBoundingRect();
+        cv::Rect window(rect.x - KEV_ROI_TRACKER_MARGIN, rect.y - KEV_ROI_TRACKER_MARGIN,
+                        rect.width + 2 * KEV_ROI_TRACKER_MARGIN, rect.height + 2 * KEV_ROI_TRACKER_MARGIN);
+
+        cv::Point2f centroid;
+
+        if(locateCentroid(rFrame, window & frameRect, rLevelTracker.getThreshold(i), centroid) == false)
+        {
+            continue;
+        }
+
+        centroid -= cv::Point2f(rect.tl());
+
+        if(m_rHasReferences[i] == false)
+        {
+            m_rReferences[i] = centroid;
+            m_rHasReferences[i] = true;
+            continue;
+        }
+
+        cv::Point2f drift = centroid - m_rReferences[i];
+
+        if(std::abs(drift.x) < KEV_ROI_TRACKER_HYSTERESIS && std::abs(drift.y) < KEV_ROI_TRACKER_HYSTERESIS)
+        {
+            continue;
+        }
+
+        cv::Point offset(cvRound(drift.x), cvRound(drift.y));
+
+        // the moved block must still lie inside the frame
+        if(offset == cv::Point() || ((rect + offset) & frameRect) != (rect + offset))
+        {
+            continue;
+        }
+
+        rROIBlocks[i].translate(offset);
+        m_rOffsets[i] += offset;
+        isMoved = true;
+    }
+
+    return isMoved;
+}
+
+/**
+ * @brief This function returns the centroid of the pixels above a threshold in a window,
+ *        weighted by their excess over the threshold.
+ * @param rFrame an image frame (CV_8UC1)
+ * @param rWindow a search window inside the frame
+ * @param nThreshold a threshold of the pixels
+ * @param rCentroid the centroid in frame coordinates
+ * @return true if any pixel exceeds the threshold, otherwise false.
+ */
+bool
+KevDemoROITracker::locateCentroid(const cv::Mat& rFrame, cv::Rect rWindow, float nThreshold,
+                                  cv::Point2f& rCentroid)
+{
+    int threshold = (int)nThreshold;
+
+    uint64_t sum = 0, sumX = 0, sumY = 0;
+
+    for(int y = rWindow.y; y < rWindow.y + rWindow.height; y++)
+    {
+        const uint8_t *rowData = rFrame.ptr<uint8_t>(y);
+
+        for(int x = rWindow.x; x < rWindow.x + rWindow.width; x++)
+        {
+            int weight = rowData[x] - threshold;
+
+            if(weight > 0)
+            {
+                sum += weight;
+                sumX += (uint64_t)weight * x;
+                sumY += (uint64_t)weight * y;
+            }
+        }
+    }
+
+    if(sum == 0)
+    {
+        return false;
+    }
+
+    rCentroid = cv::Point2f((float)sumX / sum, (float)sumY / sum);
+
+    return true;
+}
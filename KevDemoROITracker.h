@@ -0,0 +1,60 @@
+#ifndef _KEV_DEMO_ROI_TRACKER_H_
+#define _KEV_DEMO_ROI_TRACKER_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoROIBlock.h"
+#include "KevDemoLevelTracker.h"
+
+// margin of the search window around an ROI block in pixels
+#define KEV_ROI_TRACKER_MARGIN      4
+
+// minimum soft value of a LED to be located
+#define KEV_ROI_TRACKER_MIN_SOFT    0.5f
+
+// minimum centroid offset in pixels to move an ROI block
+#define KEV_ROI_TRACKER_HYSTERESIS  0.75f
+
+/**
+ * @brief a class for following the LEDs moving slightly during the data frames
+ *
+ * A LED decided on is located by the centroid of its pixels above the threshold
+ * in a window slightly larger than its ROI block. The first centroid of a LED is
+ * kept as its reference position within the block, and the block is moved by
+ * whole pixels once the centroid drifts away from the reference by more than
+ * the hysteresis. Switched-off LEDs keep their blocks until they are on again.
+ */
+class KevDemoROITracker
+{
+private:
+
+    // reference centroids relative to the top-left corners of ROI blocks
+    std::vector<cv::Point2f> m_rReferences;
+    std::vector<bool> m_rHasReferences;
+
+    // accumulated movement of ROI blocks since the lock
+    std::vector<cv::Point> m_rOffsets;
+
+public:
+
+    explicit KevDemoROITracker();
+    virtual ~KevDemoROITracker();
+
+    // start tracking the given number of ROI blocks
+    void configure(size_t nNumROIs);
+    void clear();
+
+    // move ROI blocks to the LEDs of a frame
+    bool track(const cv::Mat& rFrame, std::vector<KevDemoROIBlock>& rROIBlocks,
+               const std::vector<float>& rSoftValues, KevDemoLevelTracker& rLevelTracker);
+
+    // accessor
+    inline const std::vector<cv::Point>& getOffsets()   { return m_rOffsets; }
+
+private:
+
+    // centroid of the pixels above a threshold in a window
+    static bool locateCentroid(const cv::Mat& rFrame, cv::Rect rWindow, float nThreshold,
+                               cv::Point2f& rCentroid);
+};
+
+#endif // _KEV_DEMO_ROI_TRACKER_H_
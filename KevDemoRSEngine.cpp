@@ -0,0 +1,405 @@
+#include "KevDemoRSEngine.h"
+#include "KevDemoROISampler.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoRSEngine class
+ */
+KevDemoRSEngine::KevDemoRSEngine()
+{
+    reset();
+}
+
+/**
+ * @brief This is a destructor of KevDemoRSEngine class
+ */
+KevDemoRSEngine::~KevDemoRSEngine()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function resets the recovered symbol clock.
+ */
+void
+KevDemoRSEngine::reset()
+{
+    m_nSymbolRows = 0;
+    m_nNumClockSamples = 0;
+    m_rRuns.clear();
+    m_rSymbols.clear();
+}
+
+/**
+ * @brief This function builds a per-row intensity profile of the given LED region.
+ * @param rFrame an image frame (CV_8UC1)
+ * @param rRegion a LED region
+ * @return error information
+ */
+KevDemoError_t
+KevDemoRSEngine::extractProfile(const cv::Mat& rFrame, cv::Rect rRegion)
+{
+    if(rFrame.empty() == true || rFrame.type() != CV_8UC1 || rRegion.area() <= 0)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    if((rRegion & cv::Rect(0, 0, rFrame.cols, rFrame.rows)) != rRegion)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    m_rProfile.resize(rRegion.height);
+
+    for(int y = 0; y < rRegion.height; y++)
+    {
+        const uint8_t *row = rFrame.ptr<uint8_t>(rRegion.y + y) + rRegion.x;
+        m_rProfile[y] = (float)KevDemoROISampler::sumSpan(row, rRegion.width) / rRegion.width;
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function binarizes the profile against its local envelope and
+ *        detects the band edges of the profile.
+ * @return the number of detected edges
+ */
+uint32_t
+KevDemoRSEngine::detectEdges()
+{
+    int rows = m_rProfile.size();
+
+    m_rRuns.clear();
+
+    if(rows < KEV_VLC_RS_MIN_EDGES * KEV_VLC_RS_MIN_SYMBOL_ROWS)
+    {
+        return 0;
+    }
+
+    // no bands without enough contrast
+    auto range = std::minmax_element(m_rProfile.begin(), m_rProfile.end());
+
+    if(*range.second - *range.first < KEV_VLC_RS_MIN_CONTRAST)
+    {
+        return 0;
+    }
+
+    // the window covers a preamble run and its neighbours once the clock is recovered
+    int radius = KEV_VLC_RS_ENVELOPE_ROWS / 2;
+
+    if(isClockLocked() == true)
+    {
+        radius = std::max((int)(KEV_VLC_RS_ENVELOPE_SYMBOLS * m_nSymbolRows), KEV_VLC_RS_MIN_SYMBOL_ROWS);
+    }
+
+    // binarize each row against the midpoint of its local envelope
+    m_rLevels.resize(rows);
+
+    for(int y = 0; y < rows; y++)
+    {
+        int y0 = std::max(y - radius, 0);
+        int y1 = std::min(y + radius + 1, rows);
+
+        auto envelope = std::minmax_element(m_rProfile.begin() + y0, m_rProfile.begin() + y1);
+        float midpoint = (*envelope.first + *envelope.second) / 2;
+
+        m_rLevels[y] = (m_rProfile[y] >= midpoint) ? 1 : 0;
+    }
+
+    // suppress single-row glitches by a 3-tap majority
+    for(int y = 1; y < rows - 1; y++)
+    {
+        if(m_rLevels[y - 1] == m_rLevels[y + 1])
+        {
+            m_rLevels[y] = m_rLevels[y - 1];
+        }
+    }
+
+    // build runs of rows with the same level
+    RSRun_t run = {m_rLevels[0], 0, 0};
+
+    for(int y = 0; y < rows; y++)
+    {
+        if(m_rLevels[y] != run.level)
+        {
+            m_rRuns.push_back(run);
+            run = {m_rLevels[y], y, 0};
+        }
+
+        run.length++;
+    }
+
+    m_rRuns.push_back(run);
+
+    return m_rRuns.size() - 1;
+}
+
+/**
+ * @brief This function estimates the symbol period in rows from the interior runs,
+ *        and then smooths it over frames.
+ * @param nPacketBits the number of payload bits of a packet
+ * @return true if the symbol period is estimated from this frame, otherwise false
+ */
+bool
+KevDemoRSEngine::trainClock(uint32_t nPacketBits)
+{
+    // the first and the last runs are truncated by the region
+    if(m_rRuns.size() < KEV_VLC_RS_MIN_EDGES + 1)
+    {
+        return false;
+    }
+
+    std::vector<int> &lengths = m_rRunLengths;
+    lengths.clear();
+
+    for(uint32_t i = 1; i < m_rRuns.size() - 1; i++)
+    {
+        lengths.push_back(m_rRuns[i].length);
+    }
+
+    std::sort(lengths.begin(), lengths.end());
+
+    // single-symbol runs dominate the lower quartile of Manchester-coded bands
+    float base = lengths[lengths.size() / 4];
+    float sum = 0;
+    int count = 0;
+
+    for(int length : lengths)
+    {
+        if(length < 1.5f * base)
+        {
+            sum += length;
+            count++;
+        }
+    }
+
+    float symbolRows = sum / count;
+
+    // Manchester runs are 1 or 2 symbols long, and a preamble run 3 or 4 symbols.
+    // The ratio of the longest run tells whether the shortest runs are 1 or 2 symbols.
+    float ratio = lengths.back() / symbolRows;
+
+    if(ratio >= 1.25f && ratio < 1.75f)
+    {
+        symbolRows /= 2;
+    }
+    else if(ratio < 2.5f)
+    {
+        // no preamble, or a 4-symbol preamble with 2-symbol runs only
+        float packetRows = estimatePacketRows();
+        float packetSymbols = KEV_VLC_RS_PREAMBLE_ONES + 1 + 2 * nPacketBits;
+
+        if(packetRows <= 0 || nPacketBits == 0)
+        {
+            return false;
+        }
+
+        float periodRatio = symbolRows / (packetRows / packetSymbols);
+
+        if(periodRatio > 1.75f && periodRatio < 2.25f)
+        {
+            symbolRows /= 2;
+        }
+        else if(periodRatio < 0.75f || periodRatio > 1.25f)
+        {
+            return false;
+        }
+    }
+
+    // refine the period with all the runs of a plausible number of symbols
+    float totalRows = 0;
+    float totalSymbols = 0;
+
+    for(int length : lengths)
+    {
+        int symbols = std::max((int)(length / symbolRows + 0.5f), 1);
+
+        if(symbols <= KEV_VLC_RS_MAX_RUN_SYMBOLS)
+        {
+            totalRows += length;
+            totalSymbols += symbols;
+        }
+    }
+
+    symbolRows = totalRows / totalSymbols;
+
+    if(symbolRows < KEV_VLC_RS_MIN_SYMBOL_ROWS)
+    {
+        return false;
+    }
+
+    // exponential smoothing over frames
+    if(m_nNumClockSamples == 0)
+    {
+        m_nSymbolRows = symbolRows;
+    }
+    else
+    {
+        m_nSymbolRows = 0.75f * m_nSymbolRows + 0.25f * symbolRows;
+    }
+
+    m_nNumClockSamples++;
+
+    return true;
+}
+
+/**
+ * @brief This function estimates the packet period in rows from the distance of
+ *        the longest bright runs, which are the preambles of consecutive packets.
+ * @return the packet period in rows, or 0 if less than two preambles are found
+ */
+float
+KevDemoRSEngine::estimatePacketRows()
+{
+    int maxLength = 0;
+
+    for(uint32_t i = 1; i + 1 < m_rRuns.size(); i++)
+    {
+        maxLength = std::max(maxLength, m_rRuns[i].length);
+    }
+
+    // a preamble may absorb the last symbol of the previous payload, so use the run ends
+    int prevEnd = -1;
+    int minDistance = 0;
+
+    for(uint32_t i = 1; i + 1 < m_rRuns.size(); i++)
+    {
+        RSRun_t &run = m_rRuns[i];
+
+        if(run.level != 1 || run.length * 4 < maxLength * 3)
+        {
+            continue;
+        }
+
+        int end = run.start + run.length;
+
+        if(prevEnd >= 0 && (minDistance == 0 || end - prevEnd < minDistance))
+        {
+            minDistance = end - prevEnd;
+        }
+
+        prevEnd = end;
+    }
+
+    return (float)minDistance;
+}
+
+/**
+ * @brief This function extracts the packets of the detected bands.
+ * @param nPacketBits the number of payload bits of a packet
+ * @param rDecodedBits the payload bits of the first valid packet
+ * @return the number of valid packets
+ */
+uint32_t
+KevDemoRSEngine::decodePackets(uint32_t nPacketBits, std::vector<int>& rDecodedBits)
+{
+    rDecodedBits.clear();
+
+    if(isClockLocked() == false || nPacketBits == 0)
+    {
+        return 0;
+    }
+
+    buildSymbols();
+
+    uint32_t numPackets = 0;
+    uint32_t numOnes = 0;
+    std::vector<int> &packetBits = m_rPacketBits;
+
+    for(uint32_t i = 0; i < m_rSymbols.size(); i++)
+    {
+        // a preamble ends with a '0' following KEV_VLC_RS_PREAMBLE_ONES or more '1's
+        if(m_rSymbols[i] == 1)
+        {
+            numOnes++;
+            continue;
+        }
+
+        bool isPreamble = (m_rSymbols[i] == 0 && numOnes >= KEV_VLC_RS_PREAMBLE_ONES);
+        numOnes = 0;
+
+        if(isPreamble == true && decodePayload(i + 1, nPacketBits, packetBits) == true)
+        {
+            if(numPackets++ == 0)
+            {
+                rDecodedBits = packetBits;
+            }
+
+            // skip the payload of the packet
+            i += 2 * nPacketBits;
+        }
+    }
+
+    return numPackets;
+}
+
+/**
+ * @brief This function expands the interior runs into symbols using the symbol period.
+ *        A run of too many symbols is replaced by a break so that no packet spans it.
+ */
+void
+KevDemoRSEngine::buildSymbols()
+{
+    m_rSymbols.clear();
+
+    for(uint32_t i = 1; i + 1 < m_rRuns.size(); i++)
+    {
+        int symbols = std::max((int)(m_rRuns[i].length / m_nSymbolRows + 0.5f), 1);
+
+        if(symbols > KEV_VLC_RS_MAX_RUN_SYMBOLS)
+        {
+            m_rSymbols.push_back(KEV_VLC_RS_SYMBOL_BREAK);
+            continue;
+        }
+
+        m_rSymbols.insert(m_rSymbols.end(), symbols, (uint8_t)m_rRuns[i].level);
+    }
+}
+
+/**
+ * @brief This function decodes a Manchester-coded payload starting from the given symbol.
+ * @param nStart index of the first payload symbol
+ * @param nPacketBits the number of payload bits
+ * @param rDecodedBits decoded payload bits
+ * @return true if the whole payload is valid, otherwise false
+ */
+bool
+KevDemoRSEngine::decodePayload(uint32_t nStart, uint32_t nPacketBits, std::vector<int>& rDecodedBits)
+{
+    if(nStart + 2 * nPacketBits > m_rSymbols.size())
+    {
+        return false;
+    }
+
+    rDecodedBits.clear();
+
+    for(uint32_t i = 0; i < nPacketBits; i++)
+    {
+        uint8_t first  = m_rSymbols[nStart + 2 * i];
+        uint8_t second = m_rSymbols[nStart + 2 * i + 1];
+
+        if(first == 1 && second == 0)
+        {
+            rDecodedBits.push_back(1);
+        }
+        else if(first == 0 && second == 1)
+        {
+            rDecodedBits.push_back(0);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
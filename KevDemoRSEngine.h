@@ -0,0 +1,102 @@
+#ifndef _KEV_DEMO_RS_ENGINE_H_
+#define _KEV_DEMO_RS_ENGINE_H_
+
+#include "KevDemoConfig.h"
+
+// RS profile & band detection
+#define KEV_VLC_RS_ENVELOPE_ROWS        63
+#define KEV_VLC_RS_ENVELOPE_SYMBOLS     3
+#define KEV_VLC_RS_MIN_CONTRAST         16
+#define KEV_VLC_RS_MIN_EDGES            6
+
+// RS symbol clock
+#define KEV_VLC_RS_MIN_SYMBOL_ROWS      2
+#define KEV_VLC_RS_MAX_RUN_SYMBOLS      6
+#define KEV_VLC_RS_MIN_CLOCK_SAMPLES    3
+
+// RS packet framing: a preamble of (KEV_VLC_RS_PREAMBLE_ONES x '1', '0'),
+// followed by Manchester-coded payload bits ('10' for 1, '01' for 0)
+#define KEV_VLC_RS_PREAMBLE_ONES        3
+#define KEV_VLC_RS_SYMBOL_BREAK         2
+
+/**
+ * @brief a class for decoding rolling shutter bands of a single LED
+ *
+ * A rolling shutter camera exposes rows one after another, so a LED switched
+ * faster than the frame rate appears as horizontal bands. The engine reduces
+ * the LED region to a per-row intensity profile, detects band edges, recovers
+ * the symbol period in rows, and extracts Manchester-coded packets.
+ */
+class KevDemoRSEngine
+{
+private:
+
+    /**
+     * @brief a run of rows with the same binarized level
+     */
+    typedef struct RSRun {
+        int level;
+        int start;
+        int length;
+    } RSRun_t;
+
+    // per-row intensity profile of the LED region
+    std::vector<float> m_rProfile;
+
+    // binarized rows of the profile
+    std::vector<uint8_t> m_rLevels;
+
+    // runs of binarized rows
+    std::vector<RSRun_t> m_rRuns;
+
+    // symbols of the interior runs
+    std::vector<uint8_t> m_rSymbols;
+
+    // sorted lengths of the interior runs, and bits of a packet being decoded
+    std::vector<int> m_rRunLengths;
+    std::vector<int> m_rPacketBits;
+
+    // symbol period in rows
+    float m_nSymbolRows;
+
+    // number of frames used to estimate the symbol period
+    uint32_t m_nNumClockSamples;
+
+public:
+
+    explicit KevDemoRSEngine();
+    virtual ~KevDemoRSEngine();
+
+    void reset();
+
+    // RS decoding procedures
+    KevDemoError_t extractProfile(const cv::Mat& rFrame, cv::Rect rRegion);
+    uint32_t detectEdges();
+    bool trainClock(uint32_t nPacketBits);
+    uint32_t decodePackets(uint32_t nPacketBits, std::vector<int>& rDecodedBits);
+
+    // accessor
+    inline float getSymbolRows()    { return m_nSymbolRows; }
+
+    /**
+     * @brief This function checks whether the symbol clock is recovered or not.
+     * @return true if the symbol period is estimated over enough frames, otherwise false.
+     */
+    inline bool isClockLocked()
+    {
+        return m_nNumClockSamples >= KEV_VLC_RS_MIN_CLOCK_SAMPLES;
+    }
+
+private:
+
+    // estimate the packet period from the preambles
+    float estimatePacketRows();
+
+    // build symbols from the interior runs
+    void buildSymbols();
+
+    // decode a Manchester-coded payload
+    bool decodePayload(uint32_t nStart, uint32_t nPacketBits, std::vector<int>& rDecodedBits);
+};
+
+#endif // _KEV_DEMO_RS_ENGINE_H_
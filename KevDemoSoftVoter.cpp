@@ -0,0 +1,79 @@
+#include "KevDemoSoftVoter.h"
+#include "KevDemoBitStream.h"
+
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoSoftVoter class
+ */
+KevDemoSoftVoter::KevDemoSoftVoter()
+{
+    clear();
+}
+
+/**
+ * @brief This is a destructor of KevDemoSoftVoter class
+ */
+KevDemoSoftVoter::~KevDemoSoftVoter()
+{
+    clear();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function adds the soft values of LEDs of a frame to the sums.
+ * @param rSoftValues soft values of LEDs in [-1, 1]
+ */
+void
+KevDemoSoftVoter::vote(const std::vector<float>& rSoftValues)
+{
+    if(m_nNumVotes == 0)
+    {
+        m_rSums.assign(rSoftValues.size(), 0);
+    }
+
+    for(size_t i = 0; i < m_rSums.size() && i < rSoftValues.size(); i++)
+    {
+        m_rSums[i] += rSoftValues[i];
+    }
+
+    m_nNumVotes++;
+}
+
+/**
+ * @brief This function decides the states of LEDs by the signs of the sums.
+ * @param rDecodedSignals decided states (1 for on, 0 for off)
+ * @param rConfidences confidences of the decided states (0 to 255)
+ */
+void
+KevDemoSoftVoter::decide(std::vector<int>& rDecodedSignals, std::vector<uint8_t>& rConfidences)
+{
+    rDecodedSignals.clear();
+    rConfidences.clear();
+
+    float scale = (float)KEV_BIT_STREAM_MAX_CONFIDENCE / std::max<uint32_t>(m_nNumVotes, 1);
+
+    for(float sum : m_rSums)
+    {
+        rDecodedSignals.push_back(sum >= 0 ? 1 : 0);
+        rConfidences.push_back((uint8_t)std::min(std::abs(sum) * scale, (float)KEV_BIT_STREAM_MAX_CONFIDENCE));
+    }
+}
+
+/**
+ * @brief This function removes all the votes.
+ */
+void
+KevDemoSoftVoter::clear()
+{
+    m_rSums.clear();
+    m_nNumVotes = 0;
+}
@@ -0,0 +1,40 @@
+#ifndef _KEV_DEMO_SOFT_VOTER_H_
+#define _KEV_DEMO_SOFT_VOTER_H_
+
+#include "KevDemoConfig.h"
+
+/**
+ * @brief a class for deciding the states of LEDs over the frames of a symbol
+ *
+ * Each frame observing a symbol votes with the soft values of LEDs, i.e. the signed
+ * distances of their samples from the thresholds, and the states are decided once by
+ * the signs of the sums. A frame exposed across a symbol boundary has samples near
+ * the thresholds, so it barely moves the sums. The confidence of a decision is the
+ * magnitude of the mean soft value.
+ */
+class KevDemoSoftVoter
+{
+private:
+
+    // sums of the soft values of LEDs
+    std::vector<float> m_rSums;
+
+    // the number of frames voted
+    uint32_t m_nNumVotes;
+
+public:
+
+    explicit KevDemoSoftVoter();
+    virtual ~KevDemoSoftVoter();
+
+    // voting procedures
+    void vote(const std::vector<float>& rSoftValues);
+    void decide(std::vector<int>& rDecodedSignals, std::vector<uint8_t>& rConfidences);
+
+    void clear();
+
+    // accessor
+    inline uint32_t getNumVotes()   { return m_nNumVotes; }
+};
+
+#endif // _KEV_DEMO_SOFT_VOTER_H_
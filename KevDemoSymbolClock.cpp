@@ -0,0 +1,282 @@
+#include "KevDemoSymbolClock.h"
+
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoSymbolClock class
+ * @param nNominalPeriod nominal symbol period in frames
+ */
+KevDemoSymbolClock::KevDemoSymbolClock(float nNominalPeriod)
+{
+    setNominalPeriod(nNominalPeriod);
+}
+
+/**
+ * @brief This is a destructor of KevDemoSymbolClock class
+ */
+KevDemoSymbolClock::~KevDemoSymbolClock()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function discards the current run and the fitted grid.
+ */
+void
+KevDemoSymbolClock::reset()
+{
+    m_nSymbolPeriod = m_nNominalPeriod;
+    m_nOriginTime = 0;
+
+    m_nSumWeights = 0;
+    m_nSumIndices = 0;
+    m_nSumTimes = 0;
+    m_nSumSquaredIndices = 0;
+    m_nSumProducts = 0;
+    m_nNumBoundaries = 0;
+
+    m_nBoundaryIndex = 0;
+    m_nLastTime = 0;
+    m_rRunSignals.clear();
+    m_rRunConfidences.clear();
+    m_rSymbolSignals.clear();
+    m_bIsRunning = false;
+
+    m_rShortSignals.clear();
+    m_rShortConfidences.clear();
+    m_nShortTime = 0;
+    m_bIsShortRun = false;
+}
+
+/**
+ * @brief This function sets the nominal symbol period, and resets the clock.
+ * @param nNominalPeriod nominal symbol period in frames
+ */
+void
+KevDemoSymbolClock::setNominalPeriod(float nNominalPeriod)
+{
+    m_nNominalPeriod = std::max(nNominalPeriod, 1.0f);
+    reset();
+}
+
+/**
+ * @brief This function pushes the signals of a frame. The first frame after a reset
+ *        is regarded as the first frame of a symbol.
+ * @param nTime time of the frame in frames
+ * @param rSignals signals of all the channels
+ * @param rConfidences confidences of the signals
+ * @param rBitStream decoded bits of the symbols completed by this frame are appended
+ * @return the number of appended bits
+ */
+uint32_t
+KevDemoSymbolClock::push(double nTime, const std::vector<int>& rSignals,
+                         const std::vector<uint8_t>& rConfidences, KevDemoBitStream& rBitStream)
+{
+    if(m_bIsRunning == false)
+    {
+        m_rRunSignals = rSignals;
+        m_rRunConfidences = rConfidences;
+        m_nLastTime = nTime;
+        m_bIsRunning = true;
+
+        // the first symbol begins half a frame before its first sample
+        fitBoundary(0, nTime - 0.5);
+        return 0;
+    }
+
+    if(rSignals == m_rRunSignals)
+    {
+        // a symbol is as confident as its best sample
+        for(size_t i = 0; i < m_rRunConfidences.size() && i < rConfidences.size(); i++)
+        {
+            m_rRunConfidences[i] = std::max(m_rRunConfidences[i], rConfidences[i]);
+        }
+
+        m_nLastTime = nTime;
+        return 0;
+    }
+
+    // the run after a short one decides whether the short one is a symbol
+    uint32_t numBits = resolveShortRun(rBitStream);
+
+    // a boundary is halfway between the last sample of the run and this sample
+    double boundaryTime = (m_nLastTime + nTime) / 2;
+    int64_t index = findBoundaryIndex(boundaryTime);
+
+    if(index > m_nBoundaryIndex)
+    {
+        numBits += emitRun(index, rBitStream);
+        fitBoundary(index, boundaryTime);
+    }
+    else
+    {
+        // a boundary on the index of the previous one ends a short run, which is either
+        // a frame exposed across a boundary or a symbol of a slightly fast transmitter
+        m_rShortSignals = m_rRunSignals;
+        m_rShortConfidences = m_rRunConfidences;
+        m_nShortTime = boundaryTime;
+        m_bIsShortRun = true;
+    }
+
+    m_rRunSignals = rSignals;
+    m_rRunConfidences = rConfidences;
+    m_nLastTime = nTime;
+
+    return numBits;
+}
+
+/**
+ * @brief This function emits the symbols of the current run, which ends half a frame
+ *        after its last sample, e.g. at the end of a burst.
+ * @param rBitStream decoded bits of the run are appended
+ * @return the number of appended bits
+ */
+uint32_t
+KevDemoSymbolClock::flush(KevDemoBitStream& rBitStream)
+{
+    if(m_bIsRunning == false)
+    {
+        return 0;
+    }
+
+    uint32_t numBits = resolveShortRun(rBitStream);
+
+    int64_t index = std::max(findBoundaryIndex(m_nLastTime + 0.5), m_nBoundaryIndex + 1);
+    numBits += emitRun(index, rBitStream);
+
+    m_bIsRunning = false;
+
+    return numBits;
+}
+
+/**
+ * @brief This function returns the index of the grid boundary nearest to the given time.
+ *        An observed boundary is quantized to half frames, so a time halfway between two
+ *        grid boundaries takes the earlier one.
+ * @param nTime time of an observed boundary
+ * @return the index of the boundary
+ */
+int64_t
+KevDemoSymbolClock::findBoundaryIndex(double nTime)
+{
+    return (int64_t)ceil((nTime - m_nOriginTime) / m_nSymbolPeriod - 0.5);
+}
+
+/**
+ * @brief This function adds an observed boundary to the weighted least-squares fit of
+ *        the grid, and updates the origin and the symbol period of the grid. The period
+ *        stays nominal until enough boundaries are observed.
+ * @param nIndex index of the boundary
+ * @param nTime time of the boundary
+ */
+void
+KevDemoSymbolClock::fitBoundary(int64_t nIndex, double nTime)
+{
+    double forgetting = KEV_SYMBOL_CLOCK_FORGETTING;
+
+    m_nSumWeights        = forgetting * m_nSumWeights + 1;
+    m_nSumIndices        = forgetting * m_nSumIndices + nIndex;
+    m_nSumTimes          = forgetting * m_nSumTimes + nTime;
+    m_nSumSquaredIndices = forgetting * m_nSumSquaredIndices + (double)nIndex * nIndex;
+    m_nSumProducts       = forgetting * m_nSumProducts + nIndex * nTime;
+    m_nNumBoundaries++;
+
+    double denominator = m_nSumWeights * m_nSumSquaredIndices - m_nSumIndices * m_nSumIndices;
+
+    if(m_nNumBoundaries >= KEV_SYMBOL_CLOCK_MIN_BOUNDARIES && denominator > 0)
+    {
+        float minPeriod = m_nNominalPeriod * (1 - KEV_SYMBOL_CLOCK_MAX_DEVIATION);
+        float maxPeriod = m_nNominalPeriod * (1 + KEV_SYMBOL_CLOCK_MAX_DEVIATION);
+
+        float period = (m_nSumWeights * m_nSumProducts - m_nSumIndices * m_nSumTimes) / denominator;
+        m_nSymbolPeriod = std::min(std::max(period, minPeriod), maxPeriod);
+    }
+
+    m_nOriginTime = (m_nSumTimes - m_nSymbolPeriod * m_nSumIndices) / m_nSumWeights;
+}
+
+/**
+ * @brief This function appends the bits of the symbols of the current run.
+ * @param nEndIndex index of the boundary ending the run
+ * @param rBitStream decoded bits of the run are appended
+ * @return the number of appended bits
+ */
+uint32_t
+KevDemoSymbolClock::emitRun(int64_t nEndIndex, KevDemoBitStream& rBitStream)
+{
+    uint32_t numSymbols = nEndIndex - m_nBoundaryIndex;
+
+    for(uint32_t i = 0; i < numSymbols; i++)
+    {
+        appendSymbol(m_rRunSignals, m_rRunConfidences, rBitStream);
+    }
+
+    m_rSymbolSignals = m_rRunSignals;
+    m_nBoundaryIndex = nEndIndex;
+
+    return numSymbols * m_rRunSignals.size();
+}
+
+/**
+ * @brief This function decides the pending short run, if any, once the run after it is
+ *        known. A frame exposed across a boundary shows each channel either in its state
+ *        before or after the boundary, so such a run is merged into the following symbol.
+ *        Any other short run is a symbol, which ends on the next index of the grid.
+ * @param rBitStream decoded bits of the short run are appended if it is a symbol
+ * @return the number of appended bits
+ */
+uint32_t
+KevDemoSymbolClock::resolveShortRun(KevDemoBitStream& rBitStream)
+{
+    if(m_bIsShortRun == false)
+    {
+        return 0;
+    }
+
+    m_bIsShortRun = false;
+
+    bool isBlended = (m_rSymbolSignals.size() == m_rShortSignals.size());
+
+    for(size_t i = 0; i < m_rShortSignals.size() && isBlended == true; i++)
+    {
+        isBlended = (m_rShortSignals[i] == m_rSymbolSignals[i] || m_rShortSignals[i] == m_rRunSignals[i]);
+    }
+
+    if(isBlended == true)
+    {
+        return 0;
+    }
+
+    appendSymbol(m_rShortSignals, m_rShortConfidences, rBitStream);
+
+    m_rSymbolSignals = m_rShortSignals;
+    m_nBoundaryIndex++;
+    fitBoundary(m_nBoundaryIndex, m_nShortTime);
+
+    return m_rShortSignals.size();
+}
+
+/**
+ * @brief This function appends the bits of a symbol with their confidences.
+ * @param rSignals signals of the symbol
+ * @param rConfidences confidences of the signals
+ * @param rBitStream the bits are appended
+ */
+void
+KevDemoSymbolClock::appendSymbol(const std::vector<int>& rSignals, const std::vector<uint8_t>& rConfidences,
+                                 KevDemoBitStream& rBitStream)
+{
+    for(size_t i = 0; i < rSignals.size(); i++)
+    {
+        uint8_t confidence = (i < rConfidences.size()) ? rConfidences[i] : KEV_BIT_STREAM_MAX_CONFIDENCE;
+        rBitStream.append(rSignals[i], confidence);
+    }
+}
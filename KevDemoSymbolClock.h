@@ -0,0 +1,105 @@
+#ifndef _KEV_DEMO_SYMBOL_CLOCK_H_
+#define _KEV_DEMO_SYMBOL_CLOCK_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoBitStream.h"
+
+// nominal symbol period of a clockless transmitter in frames
+#define KEV_SYMBOL_CLOCK_NOMINAL_FRAMES     2.0f
+
+// maximum deviation of the symbol period from the nominal one
+#define KEV_SYMBOL_CLOCK_MAX_DEVIATION      0.25f
+
+// weight of the older boundaries in the fit of the boundary grid
+#define KEV_SYMBOL_CLOCK_FORGETTING         0.98
+
+// minimum number of boundaries to fit the symbol period
+#define KEV_SYMBOL_CLOCK_MIN_BOUNDARIES     3
+
+/**
+ * @brief a class for recovering the symbol timing of data channels without a clock
+ *
+ * Samples of all the channels arrive once per frame, at times in frame units.
+ * Whenever any channel changes, a symbol boundary is observed halfway between the
+ * two samples. The boundaries are modeled as a grid (origin + index * period),
+ * which is fitted by least squares to the observed boundaries and their indices,
+ * so that the quantization of boundaries to half frames is averaged out and a
+ * transmitter slightly slower or faster than the nominal rate is followed. Each
+ * observed boundary takes the index of the nearest grid boundary, and the run
+ * before it is emitted as that many symbols. A boundary on the index of the
+ * previous one ends a short run, which is held until the next run is known: a
+ * frame exposed across a boundary blends the symbols on both sides and is merged
+ * into the following symbol, while any other short run is a symbol of its own.
+ */
+class KevDemoSymbolClock
+{
+private:
+
+    // nominal and fitted symbol periods in frames, and the fitted grid origin
+    float m_nNominalPeriod;
+    float m_nSymbolPeriod;
+    double m_nOriginTime;
+
+    // weighted sums of the indices and times of the observed boundaries
+    double m_nSumWeights;
+    double m_nSumIndices;
+    double m_nSumTimes;
+    double m_nSumSquaredIndices;
+    double m_nSumProducts;
+    uint32_t m_nNumBoundaries;
+
+    // index of the last boundary, and time of the last sample
+    int64_t m_nBoundaryIndex;
+    double m_nLastTime;
+
+    // signals and confidences of the current run, and signals of the last emitted symbol
+    std::vector<int> m_rRunSignals;
+    std::vector<uint8_t> m_rRunConfidences;
+    std::vector<int> m_rSymbolSignals;
+
+    // whether a run is in progress
+    bool m_bIsRunning;
+
+    // signals and end time of a short run, pending until the next run is known
+    std::vector<int> m_rShortSignals;
+    std::vector<uint8_t> m_rShortConfidences;
+    double m_nShortTime;
+    bool m_bIsShortRun;
+
+public:
+
+    explicit KevDemoSymbolClock(float nNominalPeriod = KEV_SYMBOL_CLOCK_NOMINAL_FRAMES);
+    virtual ~KevDemoSymbolClock();
+
+    void reset();
+
+    // clock recovery procedures
+    uint32_t push(double nTime, const std::vector<int>& rSignals,
+                  const std::vector<uint8_t>& rConfidences, KevDemoBitStream& rBitStream);
+    uint32_t flush(KevDemoBitStream& rBitStream);
+
+    // accessor & mutator
+    void setNominalPeriod(float nNominalPeriod);
+    inline float getNominalPeriod()     { return m_nNominalPeriod; }
+    inline float getSymbolPeriod()      { return m_nSymbolPeriod;  }
+
+private:
+
+    // index of the grid boundary nearest to the given time
+    int64_t findBoundaryIndex(double nTime);
+
+    // add an observed boundary to the fit of the grid
+    void fitBoundary(int64_t nIndex, double nTime);
+
+    // emit the symbols of the current run
+    uint32_t emitRun(int64_t nEndIndex, KevDemoBitStream& rBitStream);
+
+    // decide whether a pending short run is a symbol
+    uint32_t resolveShortRun(KevDemoBitStream& rBitStream);
+
+    // append the bits of a symbol
+    void appendSymbol(const std::vector<int>& rSignals, const std::vector<uint8_t>& rConfidences,
+                      KevDemoBitStream& rBitStream);
+};
+
+#endif // _KEV_DEMO_SYMBOL_CLOCK_H_
@@ -0,0 +1,207 @@
+#include "KevDemoSymbolTimer.h"
+
+#include <algorithm>
+#include <cmath>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoSymbolTimer class
+ * @param nNominalPeriod nominal symbol period in frames
+ */
+KevDemoSymbolTimer::KevDemoSymbolTimer(float nNominalPeriod)
+{
+    m_nFrameInterval = 0;
+    m_bIsFixedInterval = false;
+    m_nNumSeedFrames = 0;
+
+    m_nLastTimestamp = 0;
+    m_bIsTimed = false;
+
+    m_nFrameTime = 0;
+    m_nNumMissedFrames = 0;
+
+    m_nNominalPeriod = std::max(nNominalPeriod, 1.0f);
+    m_nNumErasedSymbols = 0;
+
+    resetSymbols();
+}
+
+/**
+ * @brief This is a destructor of KevDemoSymbolTimer class
+ */
+KevDemoSymbolTimer::~KevDemoSymbolTimer()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function sets the frame interval, e.g. of a camera of a known frame rate.
+ * @param nFrameInterval frame interval in nanoseconds (0 to estimate it from the timestamps)
+ */
+void
+KevDemoSymbolTimer::setFrameInterval(double nFrameInterval)
+{
+    m_bIsFixedInterval = (nFrameInterval > 0);
+    m_nFrameInterval = std::max(nFrameInterval, 0.0);
+    m_nNumSeedFrames = 0;
+}
+
+/**
+ * @brief This function places a timestamped frame on the slot grid.
+ * @param nTimestamp capture time of the frame in nanoseconds
+ * @return the number of slots missed before the frame, or -1 if the frame is a duplicate
+ */
+int32_t
+KevDemoSymbolTimer::advance(int64_t nTimestamp)
+{
+    if(m_bIsTimed == false)
+    {
+        m_bIsTimed = true;
+        m_nLastTimestamp = nTimestamp;
+        m_nFrameTime += 1;
+        return 0;
+    }
+
+    double interval = (double)(nTimestamp - m_nLastTimestamp);
+
+    if(interval <= 0)
+    {
+        return -1;
+    }
+
+    // the first frames take a slot each while they seed the interval
+    if(m_bIsFixedInterval == false && m_nNumSeedFrames < KEV_SYMBOL_TIMER_NUM_SEED_FRAMES)
+    {
+        m_nFrameInterval = (m_nNumSeedFrames == 0) ? interval : std::min(m_nFrameInterval, interval);
+        m_nNumSeedFrames++;
+
+        m_nLastTimestamp = nTimestamp;
+        m_nFrameTime += 1;
+        return 0;
+    }
+
+    double elapsedSlots = interval / m_nFrameInterval;
+
+    if(elapsedSlots < KEV_SYMBOL_TIMER_MIN_SLOTS)
+    {
+        return -1;
+    }
+
+    if(m_bIsFixedInterval == false && elapsedSlots < 1.5)
+    {
+        m_nFrameInterval += (interval - m_nFrameInterval) * KEV_SYMBOL_TIMER_INTERVAL_GAIN;
+    }
+
+    int64_t numSlots = std::max<int64_t>(std::llround(elapsedSlots), 1);
+
+    m_nLastTimestamp = nTimestamp;
+    m_nFrameTime += numSlots;
+    m_nNumMissedFrames += numSlots - 1;
+
+    return (int32_t)(numSlots - 1);
+}
+
+/**
+ * @brief This function places a frame without a timestamp on the next slot.
+ */
+void
+KevDemoSymbolTimer::advance()
+{
+    m_nFrameTime += 1;
+}
+
+/**
+ * @brief This function forgets the symbols of the last burst at the start of a burst.
+ *        The symbol period starts over from the nominal one.
+ */
+void
+KevDemoSymbolTimer::resetSymbols()
+{
+    m_nSymbolPeriod = m_nNominalPeriod;
+
+    m_nMarkTime = m_nFrameTime;
+    m_nMarkMissed = m_nNumMissedFrames;
+    m_nLastTime = m_nFrameTime;
+    m_nLastMissed = m_nNumMissedFrames;
+    m_bHasLastSymbol = false;
+}
+
+/**
+ * @brief This function marks the current frame as the start or the middle of the symbol
+ *        to be appended next.
+ */
+void
+KevDemoSymbolTimer::markSymbol()
+{
+    m_nMarkTime = m_nFrameTime;
+    m_nMarkMissed = m_nNumMissedFrames;
+}
+
+/**
+ * @brief This function checks whether the current frame is far enough from the marked
+ *        symbol to start the next one, e.g. when frames missed in between may hide the
+ *        transition starting it.
+ * @return true if a symbol may start, otherwise false
+ */
+bool
+KevDemoSymbolTimer::isSymbolDue()
+{
+    return m_nFrameTime - m_nMarkTime >= m_nSymbolPeriod * KEV_SYMBOL_TIMER_MIN_SPACING;
+}
+
+/**
+ * @brief This function appends the bits of a decided symbol at the marked time. If frames
+ *        are missed since the last symbol, the symbols lost in between are appended
+ *        before it as erasures, which are 0 bits of no confidence. Otherwise the symbol
+ *        period follows the spacing of the two symbols.
+ * @param rSymbol bits of a symbol, or of no symbol if empty
+ * @param rBitStream the erasures and the bits are appended
+ * @return the number of appended bits
+ */
+uint32_t
+KevDemoSymbolTimer::appendSymbol(const KevDemoBitStream& rSymbol, KevDemoBitStream& rBitStream)
+{
+    uint32_t numBits = rSymbol.getNumBits();
+
+    if(numBits == 0)
+    {
+        return 0;
+    }
+
+    uint32_t numErased = 0;
+
+    if(m_bHasLastSymbol == true)
+    {
+        double spacing = m_nMarkTime - m_nLastTime;
+
+        if(m_nMarkMissed > m_nLastMissed)
+        {
+            numErased = (uint32_t)std::max<int64_t>(std::llround(spacing / m_nSymbolPeriod) - 1, 0);
+        }
+        else if(spacing > m_nSymbolPeriod * KEV_SYMBOL_TIMER_MIN_SPACING &&
+                spacing < m_nSymbolPeriod * (2 - KEV_SYMBOL_TIMER_MIN_SPACING))
+        {
+            m_nSymbolPeriod += (float)(spacing - m_nSymbolPeriod) * KEV_SYMBOL_TIMER_PERIOD_GAIN;
+        }
+    }
+
+    for(uint32_t i = 0; i < numErased * numBits; i++)
+    {
+        rBitStream.append(0, 0);
+    }
+
+    rBitStream.append(rSymbol);
+
+    m_nNumErasedSymbols += numErased;
+    m_nLastTime = m_nMarkTime;
+    m_nLastMissed = m_nMarkMissed;
+    m_bHasLastSymbol = true;
+
+    return (numErased + 1) * numBits;
+}
@@ -0,0 +1,93 @@
+#ifndef _KEV_DEMO_SYMBOL_TIMER_H_
+#define _KEV_DEMO_SYMBOL_TIMER_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoBitStream.h"
+#include "KevDemoSymbolClock.h"
+
+// gain of the estimates of the frame interval and of the symbol period
+#define KEV_SYMBOL_TIMER_INTERVAL_GAIN  0.0625
+#define KEV_SYMBOL_TIMER_PERIOD_GAIN    0.25f
+
+// number of frame intervals whose minimum seeds the estimate of the frame interval
+#define KEV_SYMBOL_TIMER_NUM_SEED_FRAMES    8
+
+// minimum frame slots between two frames, below which the later frame is a duplicate
+#define KEV_SYMBOL_TIMER_MIN_SLOTS      0.5
+
+// minimum part of a symbol period after which a symbol may start behind missed frames
+#define KEV_SYMBOL_TIMER_MIN_SPACING    0.75f
+
+/**
+ * @brief a class for scheduling the frames and symbols of a burst on frame timestamps
+ *
+ * Frames are placed on a grid of frame slots by their timestamps and the frame
+ * interval. Unless the interval is given, it is seeded by the shortest interval of
+ * the first frames, e.g. idle frames before a burst, and then follows the intervals
+ * of consecutive frames. A frame a whole slot or more behind the previous one reveals the
+ * slots of the frames missed in between, and a frame less than half a slot
+ * behind it is a duplicate. Without timestamps every frame takes the next slot.
+ *
+ * A symbol is marked at its start or middle frame, and appended once decided.
+ * When frames are missed between two marks, the symbols lost in the gap are
+ * counted from the symbol period and appended as erasures with no confidence,
+ * so the bits after the gap keep their positions in the bitstream. The symbol
+ * period is estimated from the marks of consecutive symbols without a gap.
+ */
+class KevDemoSymbolTimer
+{
+private:
+
+    // frame interval in nanoseconds (0 until estimated), whether it is given, and the
+    // number of the intervals observed to seed its estimate
+    double m_nFrameInterval;
+    bool m_bIsFixedInterval;
+    uint32_t m_nNumSeedFrames;
+
+    // timestamp of the last frame, and whether any frame is timestamped
+    int64_t m_nLastTimestamp;
+    bool m_bIsTimed;
+
+    // slot of the current frame, and the number of missed slots in total
+    double m_nFrameTime;
+    uint64_t m_nNumMissedFrames;
+
+    // nominal and estimated symbol periods in frames
+    float m_nNominalPeriod;
+    float m_nSymbolPeriod;
+
+    // time and missed slots of the marked symbol and of the last appended symbol
+    double m_nMarkTime;
+    uint64_t m_nMarkMissed;
+    double m_nLastTime;
+    uint64_t m_nLastMissed;
+    bool m_bHasLastSymbol;
+
+    // number of erased symbols in total
+    uint64_t m_nNumErasedSymbols;
+
+public:
+
+    explicit KevDemoSymbolTimer(float nNominalPeriod = KEV_SYMBOL_CLOCK_NOMINAL_FRAMES);
+    virtual ~KevDemoSymbolTimer();
+
+    // frame timing
+    void setFrameInterval(double nFrameInterval);
+    int32_t advance(int64_t nTimestamp);
+    void advance();
+
+    // symbol timing of a burst
+    void resetSymbols();
+    void markSymbol();
+    bool isSymbolDue();
+    uint32_t appendSymbol(const KevDemoBitStream& rSymbol, KevDemoBitStream& rBitStream);
+
+    // accessor
+    inline double getFrameTime()                { return m_nFrameTime;        }
+    inline double getFrameInterval()            { return m_nFrameInterval;    }
+    inline float getSymbolPeriod()              { return m_nSymbolPeriod;     }
+    inline uint64_t getNumMissedFrames()        { return m_nNumMissedFrames;  }
+    inline uint64_t getNumErasedSymbols()       { return m_nNumErasedSymbols; }
+};
+
+#endif // _KEV_DEMO_SYMBOL_TIMER_H_
@@ -0,0 +1,108 @@
+#include "KevDemoSynthSource.h"
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoSynthSource class
+ * @param rConfig configuration of the LED array
+ * @param rBits bits to be sent
+ * @param nFPS frame rate of the timestamps
+ */
+KevDemoSynthSource::KevDemoSynthSource(const KevDemoSynthConfig_t& rConfig, const std::vector<int>& rBits,
+                                       double nFPS)
+{
+    m_rConfig = rConfig;
+    m_rBits = rBits;
+    m_nSourceFPS = nFPS;
+    m_bIsOpened = false;
+}
+
+/**
+ * @brief This is a destructor of KevDemoSynthSource class
+ */
+KevDemoSynthSource::~KevDemoSynthSource()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function configures the LED array and starts the bitstream over.
+ * @return error information
+ */
+KevDemoError_t
+KevDemoSynthSource::open()
+{
+    KevDemoError_t error = m_rSynth.configure(m_rConfig);
+
+    if(error == KEV_SUCCESS)
+    {
+        error = m_rSynth.setBitstream(m_rBits);
+    }
+
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
+
+    m_rSynth.rewind();
+    restart(m_nSourceFPS);
+
+    m_bIsOpened = true;
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function renders the next frame.
+ * @param rFrame a read frame, which views the buffer of the source until the next read
+ * @return error information, KEV_ERROR_VLC_END_OF_SOURCE after the last frame
+ */
+KevDemoError_t
+KevDemoSynthSource::readFrame(KevDemoFrame_t& rFrame)
+{
+    if(m_bIsOpened == false)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    uint64_t index = m_rSynth.getFrameIndex();
+    KevDemoError_t error = m_rSynth.renderFrame(m_rFrame);
+
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
+
+    rFrame.image = m_rFrame;
+    rFrame.sequence = index;
+    rFrame.timestamp = getNominalTime(index);
+    rFrame.region = cv::Rect();
+    m_nSequence = index + 1;
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function stops rendering.
+ */
+void
+KevDemoSynthSource::close()
+{
+    m_bIsOpened = false;
+}
+
+/**
+ * @brief This function returns whether the source is rendering.
+ * @return true if opened, otherwise false
+ */
+bool
+KevDemoSynthSource::isOpened()
+{
+    return m_bIsOpened;
+}
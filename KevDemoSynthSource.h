@@ -0,0 +1,48 @@
+#ifndef _KEV_DEMO_SYNTH_SOURCE_H_
+#define _KEV_DEMO_SYNTH_SOURCE_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoFrameSource.h"
+#include "KevDemoVLCSynth.h"
+
+/**
+ * @brief a frame source of a synthetic VLC LED array
+ *
+ * The frames of a bitstream are rendered in gray into a buffer reused frame after
+ * frame, numbered by their index and stamped at the nominal frame rate, so that the
+ * decoder can be run against known bits in the same way as against a camera.
+ */
+class KevDemoSynthSource : public KevDemoFrameSource
+{
+private:
+
+    // LED array configuration and the bits to be sent
+    KevDemoSynthConfig_t m_rConfig;
+    std::vector<int> m_rBits;
+
+    // frame rate of the timestamps
+    double m_nSourceFPS;
+
+    KevDemoVLCSynth m_rSynth;
+    bool m_bIsOpened;
+
+    // rendered frame
+    cv::Mat m_rFrame;
+
+public:
+
+    explicit KevDemoSynthSource(const KevDemoSynthConfig_t& rConfig, const std::vector<int>& rBits,
+                                double nFPS = KEV_FRAME_SOURCE_DEFAULT_FPS);
+    virtual ~KevDemoSynthSource();
+
+    // source procedures
+    KevDemoError_t open();
+    KevDemoError_t readFrame(KevDemoFrame_t& rFrame);
+    void close();
+    bool isOpened();
+
+    // accessor
+    inline KevDemoVLCSynth *getSynth()          { return &m_rSynth; }
+};
+
+#endif // _KEV_DEMO_SYNTH_SOURCE_H_
@@ -0,0 +1,187 @@
+#include "KevDemoVLCBay.h"
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoVLCBay class
+ * @param nIndex bay index
+ * @param nDecodeType VLC decoder type (KEV_VLC_DEC_MI or KEV_VLC_DEC_RS)
+ * @param pPool a work pool running the bay
+ */
+KevDemoVLCBay::KevDemoVLCBay(uint32_t nIndex, int nDecodeType, KevDemoWorkPool *pPool) :
+    m_rVLCDecoder(nDecodeType),
+    m_rFrameQueue(KEV_VLC_BAY_QUEUE_SIZE)
+{
+    m_nIndex = nIndex;
+    m_pPool = pPool;
+    m_bIsScheduled = false;
+    m_bIsOpened = false;
+    m_rStats.numFrames = 0;
+    m_rStats.numDropped = 0;
+    m_rStats.numBits = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoVLCBay class. The pool must not run or queue
+ *        the bay any more.
+ */
+KevDemoVLCBay::~KevDemoVLCBay()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function starts accepting frames.
+ */
+void
+KevDemoVLCBay::open()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_rFrameQueue.open();
+    m_bIsScheduled = false;
+    m_bIsOpened = true;
+}
+
+/**
+ * @brief This function stops accepting frames and drops the queued frames. A run of
+ *        the bay already queued in the pool returns without decoding.
+ */
+void
+KevDemoVLCBay::close()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_bIsOpened = false;
+    m_rFrameQueue.close();
+    m_rFrameQueue.clear();
+}
+
+/**
+ * @brief This function queues a copy of a captured frame with its timestamp, and submits
+ *        the bay to the pool unless it is already scheduled. The oldest frame is dropped
+ *        if the bay falls behind.
+ * @param rFrame a captured frame
+ */
+void
+KevDemoVLCBay::pushFrame(const KevDemoFrame_t& rFrame)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    if(m_bIsOpened == false || rFrame.image.empty() == true)
+    {
+        return;
+    }
+
+    m_rFrameQueue.push(rFrame);
+
+    // a bay not taken by a closed pool is scheduled by the next frame
+    if(m_bIsScheduled == false)
+    {
+        m_bIsScheduled = m_pPool->submit(this);
+    }
+}
+
+/**
+ * @brief This function takes the batch of bits and frame ends decoded since the last call.
+ * @param rDecodedStream decoded bits
+ * @return true if any bit or frame end is decoded, otherwise false
+ */
+bool
+KevDemoVLCBay::takeDecodedBits(KevDemoBitStream& rDecodedStream)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    rDecodedStream.clear();
+    rDecodedStream.swap(m_rDecodedStream);
+
+    return rDecodedStream.isEmpty() == false;
+}
+
+/**
+ * @brief This function decodes the oldest queued frame on the slot of its timestamp, and
+ *        resubmits the bay to the pool if more frames are queued.
+ */
+void
+KevDemoVLCBay::runWork()
+{
+    if(m_rFrameQueue.pop(m_rFrame) == true)
+    {
+        m_rFrameStream.clear();
+
+        KevDemoError_t error = m_rVLCDecoder.decode(m_rFrame, m_rFrameStream);
+
+        QMutexLocker locker(&m_rMutex);
+
+        bool isFirstBatch = false;
+
+        m_rStats.numFrames++;
+
+        if(error == KEV_SUCCESS && m_rFrameStream.isEmpty() == false)
+        {
+            isFirstBatch = m_rDecodedStream.isEmpty();
+            m_rDecodedStream.append(m_rFrameStream);
+            m_rStats.numBits += m_rFrameStream.getNumBits();
+        }
+
+        locker.unlock();
+
+        // notify once per batch
+        if(isFirstBatch == true)
+        {
+            emit sig_bitsDecoded(m_nIndex);
+        }
+    }
+
+    QMutexLocker locker(&m_rMutex);
+
+    // run again behind the other bays queued meanwhile
+    m_bIsScheduled = (m_bIsOpened == true && m_rFrameQueue.getNumFrames() > 0 &&
+                      m_pPool->submit(this) == true);
+}
+
+/**
+ * @brief This function returns the statistics of the bay.
+ * @return statistics of the bay
+ */
+KevDemoBayStats_t
+KevDemoVLCBay::getStats()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    KevDemoBayStats_t stats = m_rStats;
+    stats.numDropped = m_rFrameQueue.getNumDropped();
+
+    return stats;
+}
+
+/**
+ * @brief This function returns the number of frames waiting to be decoded.
+ * @return the number of queued frames
+ */
+uint32_t
+KevDemoVLCBay::getNumQueuedFrames()
+{
+    return m_rFrameQueue.getNumFrames();
+}
+
+//////////////////////////////////////////////////
+// Slot Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a slot function to push a captured frame. It is called on the capture
+ *        thread and returns without waiting for decoding.
+ * @param rFrame a captured frame
+ */
+void
+KevDemoVLCBay::slot_pushFrame(KevDemoFrame_t rFrame)
+{
+    pushFrame(rFrame);
+}
@@ -0,0 +1,109 @@
+#ifndef _KEV_DEMO_VLC_BAY_H_
+#define _KEV_DEMO_VLC_BAY_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoVLCDecoder.h"
+#include "KevDemoFrameQueue.h"
+#include "KevDemoFrameSource.h"
+#include "KevDemoWorkPool.h"
+
+#include <QMutex>
+
+// capacity of the frame queue of a bay
+#define KEV_VLC_BAY_QUEUE_SIZE  4
+
+/**
+ * @brief statistics of a bay
+ */
+typedef struct KevDemoBayStats {
+    uint64_t numFrames;
+    uint64_t numDropped;
+    uint64_t numBits;
+} KevDemoBayStats_t;
+
+/**
+ * @brief a class for decoding the frames of a charging bay on a shared work pool
+ *
+ * A bay owns its decoder and a bounded drop-oldest frame queue, so the state of a
+ * bay is never touched by the others. Frames are pushed by the capture thread of
+ * the bay with their timestamps, and the bay is submitted to the pool when its
+ * first frame is queued. Each frame is decoded on the slot of its timestamp, so the
+ * frames dropped by the queue or lost by the capture do not shift the symbols.
+ * A worker decodes a single frame per run and resubmits the bay behind the other
+ * queued bays while frames remain, so every bay gets its turn. The decoded bits
+ * and frame ends are batched until they are taken, and sig_bitsDecoded is emitted
+ * once per batch.
+ */
+class KevDemoVLCBay : public QObject, public KevDemoWorkItem
+{
+    Q_OBJECT
+
+private:
+
+    // bay index
+    uint32_t m_nIndex;
+
+    // VLC decoder used only by the worker running the bay
+    KevDemoVLCDecoder m_rVLCDecoder;
+
+    // pool running the bay
+    KevDemoWorkPool *m_pPool;
+
+    // frames waiting to be decoded
+    KevDemoFrameQueue m_rFrameQueue;
+
+    // frame and decoded bits of a run
+    KevDemoFrame_t m_rFrame;
+    KevDemoBitStream m_rFrameStream;
+
+    // schedule, statistics and batched bits shared with the other threads
+    QMutex m_rMutex;
+
+    bool m_bIsScheduled;
+    bool m_bIsOpened;
+
+    KevDemoBayStats_t m_rStats;
+    KevDemoBitStream m_rDecodedStream;
+
+public:
+
+    explicit KevDemoVLCBay(uint32_t nIndex, int nDecodeType, KevDemoWorkPool *pPool);
+    virtual ~KevDemoVLCBay();
+
+    // open & close the bay
+    void open();
+    void close();
+
+    // capture stage
+    void pushFrame(const KevDemoFrame_t& rFrame);
+
+    // take the decoded bits
+    bool takeDecodedBits(KevDemoBitStream& rDecodedStream);
+
+    // work item
+    void runWork();
+
+    // accessor
+    inline uint32_t getIndex()                  { return m_nIndex;       }
+
+    /**
+     * @brief This function returns the decoder of the bay, which may be configured
+     *        only while the bay is closed.
+     * @return the VLC decoder
+     */
+    inline KevDemoVLCDecoder *getDecoder()      { return &m_rVLCDecoder; }
+
+    KevDemoBayStats_t getStats();
+    uint32_t getNumQueuedFrames();
+
+signals:
+
+    void sig_bitsDecoded(int nIndex);
+
+public slots:
+
+    // capture stage
+    void slot_pushFrame(KevDemoFrame_t rFrame);
+};
+
+#endif // _KEV_DEMO_VLC_BAY_H_
@@ -0,0 +1,1386 @@
+#include "KevDemoConfig.h"
+#include "KevDemoDiffKernel.h"
+#include "KevDemoBlobLabeler.h"
+#include "KevDemoMorphology.h"
+#include "KevDemoROISampler.h"
+#include "KevDemoVLCDecoder.h"
+#include "KevDemoVLCReplay.h"
+#include "KevDemoVLCSynth.h"
+#include "KevDemoVLCFramer.h"
+#include "KevDemoBayManager.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QCoreApplication>
+
+// default number of iterations for micro-benchmarks
+#define KEV_BENCH_NUM_ITERATIONS    200
+
+// default threshold of micro-benchmarks
+#define KEV_BENCH_THRESHOLD         100
+
+// default number of bits of a synthetic bitstream
+#define KEV_BENCH_NUM_SYNTH_BITS    1800
+
+// default number of messages and payload bytes of the FEC benchmark
+#define KEV_BENCH_NUM_FEC_MESSAGES  100
+#define KEV_BENCH_FEC_PAYLOAD_BYTES 2
+
+// camera frame rate to convert bursts into authentication latencies
+#define KEV_BENCH_CAMERA_FPS        30.0
+
+// default number of frames decoded by each bay of the bay benchmark
+#define KEV_BENCH_NUM_BAY_FRAMES    600
+
+// default number of bursts decoded by the allocation benchmark after warm-up
+#define KEV_BENCH_NUM_ALLOC_BURSTS  4
+
+//////////////////////////////////////////////////
+// Heap Allocation Counter Definition
+//////////////////////////////////////////////////
+
+// heap allocations made through operator new while counting on the current thread
+static thread_local bool g_bIsCountingAllocations = false;
+static thread_local uint64_t g_nNumHeapAllocations = 0;
+
+/**
+ * @brief This function replaces the global operator new to count heap allocations. The
+ *        array and nothrow forms fall back to it by default.
+ * @param nSize the number of bytes to be allocated
+ * @return allocated memory
+ */
+void *
+operator new(std::size_t nSize)
+{
+    if(g_bIsCountingAllocations == true)
+    {
+        g_nNumHeapAllocations++;
+    }
+
+    void *pMemory = std::malloc((nSize > 0) ? nSize : 1);
+
+    if(pMemory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pMemory;
+}
+
+/**
+ * @brief This function replaces the global operator delete paired with operator new.
+ * @param pMemory memory allocated by operator new
+ */
+void
+operator delete(void *pMemory) noexcept
+{
+    std::free(pMemory);
+}
+
+/**
+ * @brief This function replaces the global sized operator delete paired with operator new.
+ * @param pMemory memory allocated by operator new
+ * @param nSize the number of allocated bytes
+ */
+void
+operator delete(void *pMemory, std::size_t nSize) noexcept
+{
+    std::free(pMemory);
+}
+
+//////////////////////////////////////////////////
+// Benchmark Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function obtains a difference frame using the previous OpenCV chain.
+ * @param rPrevFrame a previous frame
+ * @param rCurrFrame a current frame
+ * @param rDiffFrame a result difference frame
+ * @param nThreshold threshold to obtain a B&W difference frame
+ */
+static void
+obtainReferenceDiffFrame(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame,
+                         cv::Mat& rDiffFrame, uint32_t nThreshold)
+{
+    cv::Mat prevFrame;
+    cv::Mat currFrame;
+
+    cv::GaussianBlur(rPrevFrame, prevFrame, cv::Size(5, 5), 0);
+    cv::GaussianBlur(rCurrFrame, currFrame, cv::Size(5, 5), 0);
+
+    cv::absdiff(prevFrame, currFrame, rDiffFrame);
+    cv::threshold(rDiffFrame, rDiffFrame, nThreshold, 255, CV_THRESH_BINARY);
+}
+
+/**
+ * @brief This function builds a pair of frames with LED-like blobs switching between them.
+ * @param rSize frame size
+ * @param rPrevFrame a previous frame
+ * @param rCurrFrame a current frame
+ */
+static void
+buildFramePair(cv::Size rSize, cv::Mat& rPrevFrame, cv::Mat& rCurrFrame)
+{
+    cv::RNG rng(0x4B4556);
+
+    rPrevFrame.create(rSize, CV_8UC1);
+    rng.fill(rPrevFrame, cv::RNG::UNIFORM, 0, 64);
+
+    rCurrFrame = rPrevFrame.clone();
+
+    for(int i = 0; i < 16; i++)
+    {
+        cv::Point center(rng.uniform(0, rSize.width), rng.uniform(0, rSize.height));
+        cv::circle((i & 1) ? rPrevFrame : rCurrFrame, center, 8, cv::Scalar(250), -1);
+    }
+}
+
+/**
+ * @brief This function compares the fused difference kernel with the OpenCV chain.
+ * @param rSize frame size
+ * @param nIterations the number of iterations
+ */
+static void
+benchmarkDiffKernel(cv::Size rSize, int nIterations)
+{
+    cv::Mat prevFrame;
+    cv::Mat currFrame;
+    buildFramePair(rSize, prevFrame, currFrame);
+
+    cv::Mat refDiffFrame;
+    cv::Mat fusedDiffFrame;
+    KevDemoDiffKernel kernel;
+
+    QElapsedTimer timer;
+
+    // warm up both paths to exclude one-time allocations
+    obtainReferenceDiffFrame(prevFrame, currFrame, refDiffFrame, KEV_BENCH_THRESHOLD);
+    kernel.apply(prevFrame, currFrame, fusedDiffFrame, KEV_BENCH_THRESHOLD);
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        obtainReferenceDiffFrame(prevFrame, currFrame, refDiffFrame, KEV_BENCH_THRESHOLD);
+    }
+    double refTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        kernel.apply(prevFrame, currFrame, fusedDiffFrame, KEV_BENCH_THRESHOLD);
+    }
+    double fusedTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    // count pixels differing from the reference (rounding of the blur only)
+    cv::Mat mismatch;
+    cv::compare(refDiffFrame, fusedDiffFrame, mismatch, cv::CMP_NE);
+
+    printf("diff %4dx%-4d  opencv: %8.1f us  fused: %8.1f us  speedup: %5.2fx  mismatch: %d px\n",
+           rSize.width, rSize.height, refTime, fusedTime, refTime / fusedTime,
+           cv::countNonZero(mismatch));
+}
+
+/**
+ * @brief This function compares the single-pass ROI sampler with cv::mean per ROI block.
+ * @param nNumROIs the number of ROI blocks (LED channels)
+ * @param nIterations the number of iterations
+ */
+static void
+benchmarkROISampler(int nNumROIs, int nIterations)
+{
+    cv::Mat frame(720, 1280, CV_8UC1);
+    cv::RNG rng(0x4B4556);
+    rng.fill(frame, cv::RNG::UNIFORM, 0, 256);
+
+    // place 24x24 ROI blocks on a grid of 16 columns
+    std::vector<KevDemoROIBlock> roiBlocks;
+
+    for(int i = 0; i < nNumROIs; i++)
+    {
+        int x = 40 + (i % 16) * 72;
+        int y = 40 + (i / 16) * 72;
+
+        std::vector<cv::Point> contour = {cv::Point(x, y), cv::Point(x + 23, y),
+                                          cv::Point(x + 23, y + 23), cv::Point(x, y + 23)};
+        roiBlocks.push_back(KevDemoROIBlock(contour));
+    }
+
+    KevDemoROISampler sampler;
+    sampler.configure(roiBlocks);
+
+    std::vector<float> refMeans(nNumROIs);
+    std::vector<float> means;
+
+    QElapsedTimer timer;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        for(int j = 0; j < nNumROIs; j++)
+        {
+            refMeans[j] = cv::mean(cv::Mat(frame, roiBlocks[j].getBoundingRect())).val[0];
+        }
+    }
+    double refTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        sampler.sample(frame, means);
+    }
+    double sampleTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    double maxError = 0;
+
+    for(int j = 0; j < nNumROIs; j++)
+    {
+        maxError = std::max(maxError, (double)std::abs(refMeans[j] - means[j]));
+    }
+
+    printf("roi  %4d ROIs   cv::mean: %8.1f us  sampler: %8.1f us  speedup: %5.2fx  max error: %g\n",
+           nNumROIs, refTime, sampleTime, refTime / sampleTime, maxError);
+}
+
+/**
+ * @brief This function compares the connected-component labeler with findContours and
+ *        convexHull on a noisy difference mask with LED-like blobs.
+ * @param rSize frame size
+ * @param nIterations the number of iterations
+ */
+static void
+benchmarkBlobLabeler(cv::Size rSize, int nIterations)
+{
+    cv::Mat mask(rSize, CV_8UC1);
+    cv::RNG rng(0x4B4556);
+
+    // sparse speckles of sensor noise
+    rng.fill(mask, cv::RNG::UNIFORM, 0, 256);
+    cv::threshold(mask, mask, 240, 255, CV_THRESH_BINARY);
+
+    // LED-like blobs of a valid size
+    for(int i = 0; i < 16; i++)
+    {
+        cv::Point center(rng.uniform(20, rSize.width - 20), rng.uniform(20, rSize.height - 20));
+        cv::circle(mask, center, 10, cv::Scalar(255), -1);
+    }
+
+    cv::Mat contourMask;
+    std::vector<std::vector<cv::Point> > contours;
+    std::vector<cv::Point> hull;
+    int refBlobs = 0;
+
+    QElapsedTimer timer;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        // findContours modifies its input in OpenCV 3
+        mask.copyTo(contourMask);
+        cv::findContours(contourMask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+        refBlobs = 0;
+
+        for(auto &contour : contours)
+        {
+            cv::convexHull(contour, hull);
+
+            if(cv::boundingRect(hull).area() >= 60 && cv::boundingRect(hull).area() <= 2000)
+            {
+                refBlobs++;
+            }
+        }
+    }
+    double refTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    KevDemoBlobLabeler labeler;
+    std::vector<uint32_t> selected;
+    std::vector<std::vector<cv::Point> > hulls;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        labeler.label(mask);
+        selected.clear();
+
+        const std::vector<KevDemoBlobLabeler::BlobStats_t> &components = labeler.getComponents();
+
+        for(uint32_t j = 0; j < components.size(); j++)
+        {
+            if(components[j].boundingRect.area() >= 60 && components[j].boundingRect.area() <= 2000)
+            {
+                selected.push_back(j);
+            }
+        }
+
+        labeler.buildHulls(selected, hulls);
+    }
+    double labelTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    printf("blob %4dx%-4d  contours: %8.1f us  labeler: %8.1f us  speedup: %5.2fx  blobs: %d/%zu\n",
+           rSize.width, rSize.height, refTime, labelTime, refTime / labelTime, refBlobs, selected.size());
+}
+
+/**
+ * @brief This function compares the morphological filter with the previous OpenCV chain.
+ * @param rSize frame size
+ * @param nFilterSize filter size
+ * @param nIterations the number of iterations
+ */
+static void
+benchmarkMorphology(cv::Size rSize, int nFilterSize, int nIterations)
+{
+    cv::Mat mask(rSize, CV_8UC1);
+    cv::RNG rng(0x4B4556);
+
+    // sparse speckles of a B&W difference frame
+    rng.fill(mask, cv::RNG::UNIFORM, 0, 256);
+    cv::threshold(mask, mask, 250, 255, CV_THRESH_BINARY);
+
+    cv::Mat refFrame;
+    QElapsedTimer timer;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        cv::Mat filterElement = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(nFilterSize, nFilterSize));
+
+        mask.copyTo(refFrame);
+        cv::dilate(refFrame, refFrame, filterElement);
+        cv::dilate(refFrame, refFrame, filterElement);
+        cv::erode( refFrame, refFrame, filterElement);
+    }
+    double refTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    KevDemoMorphology morphology;
+    cv::Mat frame;
+
+    timer.start();
+    for(int i = 0; i < nIterations; i++)
+    {
+        mask.copyTo(frame);
+        morphology.filter(frame, nFilterSize);
+    }
+    double morphTime = (double)timer.nsecsElapsed() / nIterations / 1000.0;
+
+    cv::Mat diffFrame;
+    cv::compare(refFrame, frame, diffFrame, cv::CMP_NE);
+
+    printf("morph %4dx%-4d k=%-2d  opencv: %8.1f us  vHGW: %8.1f us  speedup: %5.2fx  mismatches: %d\n",
+           rSize.width, rSize.height, nFilterSize, refTime, morphTime, refTime / morphTime,
+           cv::countNonZero(diffFrame));
+}
+
+/**
+ * @brief This function checks that the decoder allocates no heap memory per frame once
+ *        it reaches the steady state. Bursts of a synthetic LED array are decoded, the
+ *        first of which locks the ROIs and the second one re-locks them for warm-up, and
+ *        the allocations made through operator new during each decode() call of the
+ *        following bursts are counted per VLC state at its entry. The frame buffers of
+ *        the decoder are allocated by OpenCV, and are counted by its frame arena.
+ * @param rSize frame size
+ * @param nNumBursts the number of bursts to be decoded after warm-up
+ * @return true if nothing is allocated in the steady state, otherwise false
+ */
+static bool
+benchmarkAllocations(cv::Size rSize, int nNumBursts)
+{
+    uint32_t dataWidth = 16;
+    uint32_t numWarmupBursts = 2;
+
+    KevDemoSynthConfig_t config = KevDemoVLCSynth::getDefaultConfig(rSize, dataWidth);
+    KevDemoVLCSynth synth;
+
+    if(synth.configure(config) != KEV_SUCCESS || nNumBursts <= 0)
+    {
+        printf("alloc: %u LEDs do not fit in %dx%d\n", dataWidth, rSize.width, rSize.height);
+        return false;
+    }
+
+    std::vector<int> bits((numWarmupBursts + nNumBursts) * synth.getSymbolsPerBurst() * synth.getBitsPerSymbol());
+    cv::RNG rng(config.seed);
+
+    for(int &bit : bits)
+    {
+        bit = rng.uniform(0, 2);
+    }
+
+    synth.setBitstream(bits);
+
+    // render all the frames in advance, so that only the decoder runs while counting
+    std::vector<cv::Mat> frames(synth.getNumFrames());
+
+    for(cv::Mat &frame : frames)
+    {
+        synth.renderFrame(frame);
+    }
+
+    KevDemoVLCDecoder decoder(KEV_VLC_DEC_MI);
+    decoder.setThreshold(KEV_BENCH_THRESHOLD);
+    decoder.setDataWidth(dataWidth);
+    decoder.setClockIndex(config.clockIndex);
+
+    KevDemoBitStream bitStream;
+    cv::Mat frame;
+
+    uint32_t numWarmupFrames = numWarmupBursts * synth.getFramesPerBurst();
+    uint64_t warmupReallocations = 0;
+    uint64_t numFrames[3] = {0, 0, 0};
+    uint64_t numAllocations[3] = {0, 0, 0};
+
+    for(uint32_t i = 0; i < frames.size(); i++)
+    {
+        if(i == numWarmupFrames)
+        {
+            warmupReallocations = decoder.getNumReallocations();
+        }
+
+        frames[i].copyTo(frame);
+        bitStream.clear();
+
+        uint32_t state = decoder.getState();
+
+        g_nNumHeapAllocations = 0;
+        g_bIsCountingAllocations = (i >= numWarmupFrames);
+
+        decoder.decode(frame, bitStream);
+
+        g_bIsCountingAllocations = false;
+
+        if(i >= numWarmupFrames && state <= KEV_VLC_STATE_DATA)
+        {
+            numFrames[state]++;
+            numAllocations[state] += g_nNumHeapAllocations;
+        }
+    }
+
+    uint64_t steadyReallocations = decoder.getNumReallocations() - warmupReallocations;
+
+    printf("alloc %4dx%-4d  %d bursts  allocations/frames  idle: %llu/%llu  sync: %llu/%llu  data: %llu/%llu"
+           "  reallocations: %llu\n",
+           rSize.width, rSize.height, nNumBursts,
+           (unsigned long long)numAllocations[KEV_VLC_STATE_IDLE], (unsigned long long)numFrames[KEV_VLC_STATE_IDLE],
+           (unsigned long long)numAllocations[KEV_VLC_STATE_SYNC], (unsigned long long)numFrames[KEV_VLC_STATE_SYNC],
+           (unsigned long long)numAllocations[KEV_VLC_STATE_DATA], (unsigned long long)numFrames[KEV_VLC_STATE_DATA],
+           (unsigned long long)steadyReallocations);
+
+    return numAllocations[KEV_VLC_STATE_IDLE] == 0 && numAllocations[KEV_VLC_STATE_SYNC] == 0 &&
+           numAllocations[KEV_VLC_STATE_DATA] == 0 && steadyReallocations == 0;
+}
+
+/**
+ * @brief This function prints the throughput, the time per VLC state, and the time
+ *        to the first bit of a replay.
+ * @param rReplay a finished replay
+ * @param nWallTime wall time of the replay in seconds
+ */
+static void
+printReplayStats(KevDemoVLCReplay& rReplay, double nWallTime)
+{
+    const KevDemoReplayStats_t &stats = rReplay.getStats();
+    const char *stateNames[KEV_VLC_NUM_STATES] = {"IDLE", "SYNC", "DATA"};
+
+    double decodeTime = (double)stats.decodeTime / 1e9;
+
+    printf("  frames: %llu  wall: %.3f s (%.1f fps)  decode: %.3f s (%.1f fps)\n",
+           (unsigned long long)stats.numFrames, nWallTime, stats.numFrames / std::max(nWallTime, 1e-9),
+           decodeTime, stats.numFrames / std::max(decodeTime, 1e-9));
+    printf("  bits: %llu  (%.1f bits/s of decode time)\n",
+           (unsigned long long)stats.numBits, stats.numBits / std::max(decodeTime, 1e-9));
+
+    for(int i = 0; i < KEV_VLC_NUM_STATES; i++)
+    {
+        double stateTime = (double)stats.stateTime[i] / 1e6;
+        double perFrame = stats.stateFrames[i] ? stateTime / stats.stateFrames[i] : 0;
+
+        printf("  %s: %6llu frames  %10.2f ms  %8.3f ms/frame\n", stateNames[i],
+               (unsigned long long)stats.stateFrames[i], stateTime, perFrame);
+    }
+
+    if(stats.firstBitFrame < 0)
+    {
+        printf("  first bit: none\n");
+    }
+    else if(rReplay.getSourceFPS() > 0)
+    {
+        printf("  first bit: frame %lld  stream %.3f s  decode %.2f ms\n",
+               (long long)stats.firstBitFrame, stats.firstBitFrame / rReplay.getSourceFPS(),
+               (double)stats.firstBitTime / 1e6);
+    }
+    else
+    {
+        printf("  first bit: frame %lld  decode %.2f ms\n",
+               (long long)stats.firstBitFrame, (double)stats.firstBitTime / 1e6);
+    }
+}
+
+/**
+ * @brief This function compares the decoded bits with the expected ones and prints the result.
+ * @param rExpected expected bits
+ * @param rDecoded decoded bits
+ * @return true if the bitstreams are identical, otherwise false
+ */
+static bool
+printBitDiff(const std::vector<int>& rExpected, const std::vector<int>& rDecoded)
+{
+    KevDemoBitDiff_t diff = KevDemoVLCReplay::compareBits(rExpected, rDecoded);
+
+    double ber = (double)(diff.numErrors + diff.numMissing) / std::max<size_t>(rExpected.size(), 1);
+
+    printf("  expected: %zu bits  errors: %llu/%llu  missing: %llu  extra: %llu  BER: %.2e\n",
+           rExpected.size(), (unsigned long long)diff.numErrors,
+           (unsigned long long)diff.numCompared, (unsigned long long)diff.numMissing,
+           (unsigned long long)diff.numExtra, ber);
+
+    return diff.numErrors == 0 && diff.numMissing == 0 && diff.numExtra == 0;
+}
+
+/**
+ * @brief This function replays a recorded source through the decoder and reports
+ *        the throughput, the time per VLC state, and the time to the first bit.
+ * @param argc the number of arguments following "replay"
+ * @param argv arguments following "replay"
+ * @return 0 on success, -1 on bad arguments, -2 if the bitstream differs from the expected one
+ */
+static int
+benchmarkReplay(int argc, char *argv[])
+{
+    if(argc < 1)
+    {
+        return -1;
+    }
+
+    QString source(argv[0]);
+    QString expectPath = source + ".bits";
+
+    int decodeType = KEV_VLC_DEC_MI;
+    uint32_t dataWidth = 16;
+    uint32_t clockIndex = 0;
+    uint32_t threshold = KEV_VLC_DEFAULT_THRESHOLD;
+    uint32_t idleScale = KEV_ACTIVITY_DEFAULT_SCALE;
+    uint64_t maxFrames = 0;
+    bool clockless = false;
+    bool manchester = false;
+    bool hard = false;
+    bool untracked = false;
+    bool verbose = false;
+
+    for(int i = 1; i < argc; i++)
+    {
+        QString option(argv[i]);
+        bool hasValue = (i + 1 < argc);
+
+        if(option == "--mi")                            decodeType = KEV_VLC_DEC_MI;
+        else if(option == "--rs")                       decodeType = KEV_VLC_DEC_RS;
+        else if(option == "--verbose")                  verbose = true;
+        else if(option == "--clockless")                clockless = true;
+        else if(option == "--manchester")               manchester = true;
+        else if(option == "--hard")                     hard = true;
+        else if(option == "--untracked")                untracked = true;
+        else if(option == "--width" && hasValue)        dataWidth = atoi(argv[++i]);
+        else if(option == "--clock" && hasValue)        clockIndex = atoi(argv[++i]);
+        else if(option == "--threshold" && hasValue)    threshold = atoi(argv[++i]);
+        else if(option == "--frames" && hasValue)       maxFrames = atoll(argv[++i]);
+        else if(option == "--idle-scale" && hasValue)   idleScale = atoi(argv[++i]);
+        else if(option == "--expect" && hasValue)       expectPath = argv[++i];
+        else                                            return -1;
+    }
+
+    KevDemoVLCDecoder decoder(decodeType);
+    decoder.setThreshold(threshold);
+    decoder.setDataWidth(dataWidth);
+    decoder.setClockIndex(clockIndex);
+    decoder.setIdleScale(idleScale);
+    decoder.setClockless(clockless);
+    decoder.setManchester(manchester);
+    decoder.setSoftDecision(!hard);
+    decoder.setTracking(!untracked);
+
+    if(verbose == true)
+    {
+        QObject::connect(&decoder, &KevDemoVLCDecoder::sig_printDebugMessage,
+                         [](QString rString) { printf("  %s\n", rString.toStdString().c_str()); });
+    }
+
+    KevDemoVLCReplay replay(&decoder);
+
+    if(replay.open(source) != KEV_SUCCESS)
+    {
+        printf("replay: cannot open %s\n", source.toStdString().c_str());
+        return -1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    KevDemoError_t error = replay.run(maxFrames);
+
+    double wallTime = (double)timer.nsecsElapsed() / 1e9;
+
+    if(error != KEV_SUCCESS)
+    {
+        printf("replay: decoding failed with error %d\n", error);
+        return -1;
+    }
+
+    printf("replay %s (%s, width %u, clock %s, threshold %u, idle scale %u, %s decision)\n", source.toStdString().c_str(),
+           (decodeType == KEV_VLC_DEC_RS) ? "RS" : "MI", dataWidth,
+           (clockless == true) ? "none" : QString::number(clockIndex).toStdString().c_str(),
+           threshold, decoder.getIdleScale(), (manchester == true) ? "manchester" : (hard == true) ? "hard" : "soft");
+
+    printReplayStats(replay, wallTime);
+
+    // compare with the sidecar bitstream if any
+    if(QFileInfo(expectPath).isFile() == false)
+    {
+        return 0;
+    }
+
+    std::vector<int> expectedBits;
+
+    if(KevDemoVLCReplay::loadBits(expectPath, expectedBits) != KEV_SUCCESS)
+    {
+        printf("replay: cannot open %s\n", expectPath.toStdString().c_str());
+        return -1;
+    }
+
+    if(printBitDiff(expectedBits, replay.getDecodedBits()) == false)
+    {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief This function renders a synthetic LED array carrying a random bitstream,
+ *        decodes it with the MIMO decoder, and reports the throughput and bit-error rate.
+ *        The frames and the bitstream can be written out for the replay benchmark.
+ *        Frames are timestamped at the camera frame rate, and may be dropped at random
+ *        before decoding to exercise the symbol timing over the missed frames, and
+ *        cropped to the data region of the decoder as the capture stage crops them.
+ * @param argc the number of arguments following "synth"
+ * @param argv arguments following "synth"
+ * @return 0 on success, -1 on bad arguments, -2 if the decoded bitstream has errors
+ */
+static int
+benchmarkSynth(int argc, char *argv[])
+{
+    cv::Size frameSize(640, 480);
+    uint32_t dataWidth = 16;
+    uint32_t threshold = KEV_BENCH_THRESHOLD;
+    uint32_t idleScale = KEV_ACTIVITY_DEFAULT_SCALE;
+    uint64_t numBits = KEV_BENCH_NUM_SYNTH_BITS;
+    bool hard = false;
+    bool untracked = false;
+    bool untimed = false;
+    bool cropped = false;
+    double dropRate = 0;
+    QString outputPath;
+
+    KevDemoSynthConfig_t config = KevDemoVLCSynth::getDefaultConfig(frameSize, dataWidth);
+
+    for(int i = 0; i < argc; i++)
+    {
+        QString option(argv[i]);
+        bool hasValue = (i + 1 < argc);
+
+        if(option == "--size" && hasValue)
+        {
+            if(sscanf(argv[++i], "%dx%d", &frameSize.width, &frameSize.height) != 2)
+            {
+                return -1;
+            }
+        }
+        else if(option == "--width" && hasValue)        dataWidth = atoi(argv[++i]);
+        else if(option == "--clock" && hasValue)        config.clockIndex = atoi(argv[++i]);
+        else if(option == "--clockless")                config.clockless = true;
+        else if(option == "--manchester")               config.manchester = true;
+        else if(option == "--hard")                     hard = true;
+        else if(option == "--untracked")                untracked = true;
+        else if(option == "--untimed")                  untimed = true;
+        else if(option == "--crop")                     cropped = true;
+        else if(option == "--drop" && hasValue)         dropRate = atof(argv[++i]);
+        else if(option == "--threshold" && hasValue)    threshold = atoi(argv[++i]);
+        else if(option == "--bits" && hasValue)         numBits = atoll(argv[++i]);
+        else if(option == "--idle-scale" && hasValue)   idleScale = atoi(argv[++i]);
+        else if(option == "--noise" && hasValue)        config.noiseSigma = atof(argv[++i]);
+        else if(option == "--blur" && hasValue)         config.blurSigma = atof(argv[++i]);
+        else if(option == "--flicker" && hasValue)      config.flickerAmplitude = atof(argv[++i]);
+        else if(option == "--jitter" && hasValue)       config.jitterAmplitude = atof(argv[++i]);
+        else if(option == "--sway" && hasValue)         config.swayAmplitude = atof(argv[++i]);
+        else if(option == "--seed" && hasValue)         config.seed = strtoull(argv[++i], NULL, 0);
+        else if(option == "--write" && hasValue)        outputPath = argv[++i];
+        else                                            return -1;
+    }
+
+    config.frameSize = frameSize;
+    config.dataWidth = dataWidth;
+
+    // Manchester coding needs the clock LED
+    if(config.clockless == true && config.manchester == true)
+    {
+        return -1;
+    }
+
+    KevDemoVLCSynth synth;
+
+    if(synth.configure(config) != KEV_SUCCESS)
+    {
+        printf("synth: %u LEDs do not fit in %dx%d\n", dataWidth, frameSize.width, frameSize.height);
+        return -1;
+    }
+
+    // a random bitstream reproducible by the seed
+    std::vector<int> bits(numBits);
+    cv::RNG rng(config.seed);
+
+    for(int &bit : bits)
+    {
+        bit = rng.uniform(0, 2);
+    }
+
+    synth.setBitstream(bits);
+
+    KevDemoVLCDecoder decoder(KEV_VLC_DEC_MI);
+    decoder.setThreshold(threshold);
+    decoder.setDataWidth(dataWidth);
+    decoder.setClockIndex(config.clockIndex);
+    decoder.setIdleScale(idleScale);
+    decoder.setClockless(config.clockless);
+    decoder.setManchester(config.manchester);
+    decoder.setSoftDecision(!hard);
+    decoder.setTracking(!untracked);
+
+    KevDemoVLCReplay replay(&decoder);
+
+    if(outputPath.isEmpty() == false && QDir().mkpath(outputPath) == false)
+    {
+        printf("synth: cannot create %s\n", outputPath.toStdString().c_str());
+        return -1;
+    }
+
+    // frame drops reproducible by the seed, independent of the bitstream
+    cv::RNG dropRng(config.seed ^ 0x5a5a5a5a);
+    uint64_t numDropped = 0;
+
+    // pixels of the cropped frames, each cropped to the data region after the previous frame
+    uint64_t numCropped = 0;
+    double croppedArea = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    KevDemoFrame_t frame;
+
+    while(synth.renderFrame(frame.image) == KEV_SUCCESS)
+    {
+        frame.sequence = synth.getFrameIndex() - 1;
+        frame.timestamp = (int64_t)(frame.sequence * 1e9 / KEV_BENCH_CAMERA_FPS);
+        frame.region = (cropped == true) ? decoder.getDataRegion() : cv::Rect();
+
+        if(outputPath.isEmpty() == false)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "frame_%06llu.png", (unsigned long long)frame.sequence);
+            cv::imwrite(QDir(outputPath).filePath(name).toStdString(), frame.image);
+        }
+
+        if(dropRate > 0 && dropRng.uniform(0.0, 1.0) < dropRate)
+        {
+            numDropped++;
+            continue;
+        }
+
+        if(frame.region.area() > 0)
+        {
+            numCropped++;
+            croppedArea += (double)frame.region.area() / frame.image.total();
+        }
+
+        KevDemoError_t error = (untimed == true) ? replay.decodeFrame(frame.image) :
+                                                   replay.decodeFrame(frame);
+
+        if(error != KEV_SUCCESS)
+        {
+            printf("synth: decoding failed\n");
+            return -1;
+        }
+    }
+
+    double wallTime = (double)timer.nsecsElapsed() / 1e9;
+
+    printf("synth %dx%d (MI, width %u, clock %s, threshold %u, idle scale %u, %s decision, noise %.1f, blur %.1f, flicker %.2f, jitter %.2f, sway %.1f, drop %.3f%s%s)\n",
+           frameSize.width, frameSize.height, dataWidth,
+           (config.clockless == true) ? "none" : QString::number(config.clockIndex).toStdString().c_str(),
+           threshold, decoder.getIdleScale(), (config.manchester == true) ? "manchester" : (hard == true) ? "hard" : "soft",
+           config.noiseSigma, config.blurSigma, config.flickerAmplitude, config.jitterAmplitude,
+           config.swayAmplitude, dropRate, (untracked == true) ? ", untracked" : "", (untimed == true) ? ", untimed" : "");
+
+    printReplayStats(replay, wallTime);
+
+    printf("  dropped: %llu  missed: %llu frames  erased: %llu symbols\n",
+           (unsigned long long)numDropped, (unsigned long long)decoder.getNumMissedFrames(),
+           (unsigned long long)decoder.getNumErasedSymbols());
+
+    if(cropped == true)
+    {
+        printf("  cropped: %llu frames  mean area: %.1f%% of a frame\n",
+               (unsigned long long)numCropped, (numCropped > 0) ? croppedArea * 100 / numCropped : 0.0);
+    }
+
+    // write the transmitted bitstream as the sidecar of the frames
+    if(outputPath.isEmpty() == false)
+    {
+        QFile file(outputPath + ".bits");
+
+        if(file.open(QIODevice::WriteOnly | QIODevice::Text) == true)
+        {
+            QByteArray text;
+
+            for(int bit : synth.getExpectedBits())
+            {
+                text.append(bit ? '1' : '0');
+            }
+
+            text.append('\n');
+            file.write(text);
+        }
+    }
+
+    if(printBitDiff(synth.getExpectedBits(), replay.getDecodedBits()) == false)
+    {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief This function computes the latencies of requests starting at every burst until
+ *        the first successful burst, as if a failed burst were retried with the next one.
+ * @param rSuccesses whether each burst delivers its message
+ * @param rLatencies latencies in bursts of the requests followed by a successful burst
+ */
+static void
+computeRetryLatencies(const std::vector<bool>& rSuccesses, std::vector<double>& rLatencies)
+{
+    rLatencies.clear();
+
+    int64_t next = -1;
+
+    for(int64_t b = (int64_t)rSuccesses.size() - 1; b >= 0; b--)
+    {
+        if(rSuccesses[b] == true)
+        {
+            next = b;
+        }
+
+        if(next >= 0)
+        {
+            rLatencies.push_back(next - b + 1);
+        }
+    }
+
+    std::sort(rLatencies.begin(), rLatencies.end());
+}
+
+/**
+ * @brief This function returns a percentile of sorted values.
+ * @param rValues sorted values
+ * @param nPercent percentile
+ * @return the value, or 0 if there is no value
+ */
+static double
+getPercentile(const std::vector<double>& rValues, double nPercent)
+{
+    if(rValues.empty() == true)
+    {
+        return 0;
+    }
+
+    size_t index = (size_t)ceil(nPercent / 100 * rValues.size());
+
+    return rValues[std::min(std::max<size_t>(index, 1), rValues.size()) - 1];
+}
+
+/**
+ * @brief This function sends a message per burst of a synthetic LED array over a sweep of
+ *        noise levels, and compares uncoded messages with framed messages corrected by FEC.
+ *        An uncoded message takes the leading bits of a burst as they are, and a framed
+ *        one is a frame of KevDemoVLCFramer. A failed message is retried with the next
+ *        burst, and the latency of authentication is accounted from the burst of a request.
+ * @param argc the number of arguments following "fec"
+ * @param argv arguments following "fec"
+ * @return 0 on success, -1 on bad arguments
+ */
+static int
+benchmarkFEC(int argc, char *argv[])
+{
+    cv::Size frameSize(640, 480);
+    uint32_t dataWidth = 16;
+    uint32_t threshold = KEV_BENCH_THRESHOLD;
+    uint32_t numMessages = KEV_BENCH_NUM_FEC_MESSAGES;
+    uint32_t numBytes = KEV_BENCH_FEC_PAYLOAD_BYTES;
+    QStringList noiseLevels = QString("0,10,20,30,40").split(',');
+
+    KevDemoSynthConfig_t config = KevDemoVLCSynth::getDefaultConfig(frameSize, dataWidth);
+
+    for(int i = 0; i < argc; i++)
+    {
+        QString option(argv[i]);
+        bool hasValue = (i + 1 < argc);
+
+        if(option == "--size" && hasValue)
+        {
+            if(sscanf(argv[++i], "%dx%d", &frameSize.width, &frameSize.height) != 2)
+            {
+                return -1;
+            }
+        }
+        else if(option == "--width" && hasValue)        dataWidth = atoi(argv[++i]);
+        else if(option == "--clock" && hasValue)        config.clockIndex = atoi(argv[++i]);
+        else if(option == "--clockless")                config.clockless = true;
+        else if(option == "--manchester")               config.manchester = true;
+        else if(option == "--threshold" && hasValue)    threshold = atoi(argv[++i]);
+        else if(option == "--messages" && hasValue)     numMessages = atoi(argv[++i]);
+        else if(option == "--bytes" && hasValue)        numBytes = atoi(argv[++i]);
+        else if(option == "--noise" && hasValue)        noiseLevels = QString(argv[++i]).split(',');
+        else if(option == "--blur" && hasValue)         config.blurSigma = atof(argv[++i]);
+        else if(option == "--flicker" && hasValue)      config.flickerAmplitude = atof(argv[++i]);
+        else if(option == "--jitter" && hasValue)       config.jitterAmplitude = atof(argv[++i]);
+        else if(option == "--seed" && hasValue)         config.seed = strtoull(argv[++i], NULL, 0);
+        else                                            return -1;
+    }
+
+    config.frameSize = frameSize;
+    config.dataWidth = dataWidth;
+
+    if(numBytes > KEV_VLC_FRAME_MAX_PAYLOAD || (config.clockless == true && config.manchester == true))
+    {
+        return -1;
+    }
+
+    KevDemoVLCSynth synth;
+
+    if(synth.configure(config) != KEV_SUCCESS)
+    {
+        printf("fec: %u LEDs do not fit in %dx%d\n", dataWidth, frameSize.width, frameSize.height);
+        return -1;
+    }
+
+    uint32_t burstBits = synth.getSymbolsPerBurst() * synth.getBitsPerSymbol();
+    uint32_t frameBits = KevDemoVLCFramer::getFrameBits(numBytes);
+
+    if(frameBits > burstBits)
+    {
+        printf("fec: a frame of %u bits does not fit in a burst of %u bits\n", frameBits, burstBits);
+        return -1;
+    }
+
+    // random messages, each framed and padded to a burst
+    KevDemoVLCFramer framer;
+    std::vector<KevDemoBitStream> payloads(numMessages);
+    std::vector<KevDemoBitStream> frames(numMessages);
+    std::vector<int> bits;
+    cv::RNG rng(config.seed);
+
+    for(uint32_t m = 0; m < numMessages; m++)
+    {
+        std::vector<uint8_t> payload(numBytes);
+
+        for(uint8_t &byte : payload)
+        {
+            byte = rng.uniform(0, 256);
+            payloads[m].appendBits(byte, 8);
+        }
+
+        framer.encode(payload, frames[m]);
+
+        size_t offset = bits.size();
+        frames[m].unpack(bits);
+        bits.resize(offset + burstBits, 0);
+    }
+
+    uint32_t framesPerBurst = synth.getFramesPerBurst();
+    double burstTime = framesPerBurst / KEV_BENCH_CAMERA_FPS * 1e3;
+
+    printf("fec %dx%d (MI, width %u, clock %s, threshold %u, %u messages of %u bytes, frame %u bits, burst %u bits, %.0f ms)\n",
+           frameSize.width, frameSize.height, dataWidth,
+           (config.clockless == true) ? "none" : QString::number(config.clockIndex).toStdString().c_str(),
+           threshold, numMessages, numBytes, frameBits, burstBits, burstTime);
+    printf("  noise   raw BER  uncoded  framed  corrected  rejected  latency uncoded (mean/p99)  framed (mean/p99)\n");
+
+    for(const QString &level : noiseLevels)
+    {
+        config.noiseSigma = level.toFloat();
+
+        synth.configure(config);
+        synth.setBitstream(bits);
+
+        // the same frames go through an uncoded decoder and a framed decoder
+        KevDemoVLCDecoder rawDecoder(KEV_VLC_DEC_MI);
+        KevDemoVLCDecoder fecDecoder(KEV_VLC_DEC_MI);
+
+        for(KevDemoVLCDecoder *decoder : {&rawDecoder, &fecDecoder})
+        {
+            decoder->setThreshold(threshold);
+            decoder->setDataWidth(dataWidth);
+            decoder->setClockIndex(config.clockIndex);
+            decoder->setClockless(config.clockless);
+            decoder->setManchester(config.manchester);
+        }
+
+        fecDecoder.setFramed(true);
+
+        KevDemoBitStream rawStream, fecStream, message;
+        std::vector<bool> rawSuccesses(numMessages, false);
+        std::vector<bool> fecSuccesses(numMessages, false);
+        uint64_t numErrors = 0, numCompared = 0;
+        cv::Mat frame, rawFrame;
+
+        while(synth.renderFrame(frame) == KEV_SUCCESS)
+        {
+            uint64_t burst = (synth.getFrameIndex() - 1) / framesPerBurst;
+
+            // the decoders draw over their frames
+            frame.copyTo(rawFrame);
+
+            rawDecoder.decode(rawFrame, rawStream);
+            fecDecoder.decode(frame, fecStream);
+
+            while(rawStream.popFrame(message) == true && burst < numMessages)
+            {
+                const KevDemoBitStream &sent = frames[burst];
+                uint32_t numBits = std::min(message.getNumBits(), frameBits);
+
+                for(uint32_t i = 0; i < frameBits; i++)
+                {
+                    numErrors += (i >= numBits || message.getBit(i) != sent.getBit(i));
+                }
+
+                numCompared += frameBits;
+
+                bool isCorrect = (message.getNumBits() >= numBytes * 8);
+
+                for(uint32_t i = 0; i < numBytes * 8 && isCorrect == true; i++)
+                {
+                    isCorrect = (message.getBit(i) == sent.getBit(i));
+                }
+
+                rawSuccesses[burst] = rawSuccesses[burst] || isCorrect;
+            }
+
+            while(fecStream.popFrame(message) == true && burst < numMessages)
+            {
+                bool isCorrect = (message.getNumBits() == numBytes * 8);
+
+                for(uint32_t i = 0; i < numBytes * 8 && isCorrect == true; i++)
+                {
+                    isCorrect = (message.getBit(i) == payloads[burst].getBit(i));
+                }
+
+                fecSuccesses[burst] = fecSuccesses[burst] || isCorrect;
+            }
+        }
+
+        std::vector<double> rawLatencies, fecLatencies;
+
+        computeRetryLatencies(rawSuccesses, rawLatencies);
+        computeRetryLatencies(fecSuccesses, fecLatencies);
+
+        double rawMean = rawLatencies.empty() ? 0 : std::accumulate(rawLatencies.begin(), rawLatencies.end(), 0.0) / rawLatencies.size();
+        double fecMean = fecLatencies.empty() ? 0 : std::accumulate(fecLatencies.begin(), fecLatencies.end(), 0.0) / fecLatencies.size();
+
+        const KevDemoFramerStats_t &stats = fecDecoder.getFramerStats();
+
+        printf("  %5.1f  %8.2e  %6.1f%%  %5.1f%%  %9llu  %8llu  %10.0f / %6.0f ms       %6.0f / %6.0f ms\n",
+               config.noiseSigma, (double)numErrors / std::max<uint64_t>(numCompared, 1),
+               100.0 * std::count(rawSuccesses.begin(), rawSuccesses.end(), true) / std::max<uint32_t>(numMessages, 1),
+               100.0 * std::count(fecSuccesses.begin(), fecSuccesses.end(), true) / std::max<uint32_t>(numMessages, 1),
+               (unsigned long long)stats.numCorrectedBits,
+               (unsigned long long)(stats.numTruncated + stats.numCorrupted),
+               rawMean * burstTime, getPercentile(rawLatencies, 99) * burstTime,
+               fecMean * burstTime, getPercentile(fecLatencies, 99) * burstTime);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief This function decodes the same number of frames on every bay of a bay manager,
+ *        over a sweep of the numbers of bays and workers, and reports the aggregate
+ *        throughput. The bays share the frames of a synthetic LED array, each one from
+ *        its own offset, and a bay is fed as soon as its queue has room, so no frame is
+ *        dropped and the throughput is bound by decoding.
+ * @param argc the number of arguments following "bays"
+ * @param argv arguments following "bays"
+ * @return 0 on success, -1 on bad arguments
+ */
+static int
+benchmarkBays(int argc, char *argv[])
+{
+    cv::Size frameSize(640, 480);
+    uint32_t dataWidth = 16;
+    uint32_t threshold = KEV_BENCH_THRESHOLD;
+    uint32_t numFrames = KEV_BENCH_NUM_BAY_FRAMES;
+    QStringList bayCounts = QString("1,2,4,8,12").split(',');
+    QStringList workerCounts = QString("1,2,4,%1").arg(QThread::idealThreadCount()).split(',');
+
+    KevDemoSynthConfig_t config = KevDemoVLCSynth::getDefaultConfig(frameSize, dataWidth);
+
+    for(int i = 0; i < argc; i++)
+    {
+        QString option(argv[i]);
+        bool hasValue = (i + 1 < argc);
+
+        if(option == "--size" && hasValue)
+        {
+            if(sscanf(argv[++i], "%dx%d", &frameSize.width, &frameSize.height) != 2)
+            {
+                return -1;
+            }
+        }
+        else if(option == "--width" && hasValue)        dataWidth = atoi(argv[++i]);
+        else if(option == "--threshold" && hasValue)    threshold = atoi(argv[++i]);
+        else if(option == "--frames" && hasValue)       numFrames = atoi(argv[++i]);
+        else if(option == "--bays" && hasValue)         bayCounts = QString(argv[++i]).split(',');
+        else if(option == "--workers" && hasValue)      workerCounts = QString(argv[++i]).split(',');
+        else if(option == "--noise" && hasValue)        config.noiseSigma = atof(argv[++i]);
+        else                                            return -1;
+    }
+
+    config.frameSize = frameSize;
+    config.dataWidth = dataWidth;
+
+    KevDemoVLCSynth synth;
+
+    if(synth.configure(config) != KEV_SUCCESS)
+    {
+        printf("bays: %u LEDs do not fit in %dx%d\n", dataWidth, frameSize.width, frameSize.height);
+        return -1;
+    }
+
+    // a few bursts of random bits shared by the bays
+    std::vector<int> bits(KEV_BENCH_NUM_SYNTH_BITS);
+    cv::RNG rng(config.seed);
+
+    for(int &bit : bits)
+    {
+        bit = rng.uniform(0, 2);
+    }
+
+    synth.setBitstream(bits);
+
+    std::vector<cv::Mat> frames(synth.getNumFrames());
+
+    for(cv::Mat &frame : frames)
+    {
+        synth.renderFrame(frame);
+    }
+
+    printf("bays %dx%d (MI, width %u, threshold %u, %u frames per bay, %d cores)\n",
+           frameSize.width, frameSize.height, dataWidth, threshold, numFrames, QThread::idealThreadCount());
+    printf("  bays  workers  wall (s)  frames/s  speedup  steals  dropped  bits\n");
+
+    for(const QString &bayCount : bayCounts)
+    {
+        uint32_t numBays = bayCount.toInt();
+        double baseRate = 0;
+
+        for(const QString &workerCount : workerCounts)
+        {
+            KevDemoBayManager manager(workerCount.toInt());
+
+            for(uint32_t b = 0; b < numBays; b++)
+            {
+                KevDemoVLCDecoder *decoder = manager.getBay(manager.addBay(KEV_VLC_DEC_MI))->getDecoder();
+
+                decoder->setThreshold(threshold);
+                decoder->setDataWidth(dataWidth);
+            }
+
+            manager.open();
+
+            QElapsedTimer timer;
+            timer.start();
+
+            // feed the bays in turn at the camera frame rate, each one as soon as its queue has room
+            KevDemoFrame_t frame;
+
+            for(uint32_t f = 0; f < numFrames; f++)
+            {
+                frame.sequence = f;
+                frame.timestamp = (int64_t)(f * 1e9 / KEV_BENCH_CAMERA_FPS);
+                frame.region = cv::Rect();
+
+                for(uint32_t b = 0; b < numBays; b++)
+                {
+                    KevDemoVLCBay *bay = manager.getBay(b);
+
+                    while(bay->getNumQueuedFrames() >= KEV_VLC_BAY_QUEUE_SIZE)
+                    {
+                        QThread::yieldCurrentThread();
+                    }
+
+                    frame.image = frames[(f + b * frames.size() / numBays) % frames.size()];
+                    bay->pushFrame(frame);
+                }
+            }
+
+            // wait for the last frames
+            uint64_t numBits = 0, numDropped = 0;
+
+            for(uint32_t b = 0; b < numBays; b++)
+            {
+                while(manager.getBay(b)->getStats().numFrames + manager.getBay(b)->getStats().numDropped < numFrames)
+                {
+                    QThread::usleep(100);
+                }
+            }
+
+            double wallTime = (double)timer.nsecsElapsed() / 1e9;
+
+            for(uint32_t b = 0; b < numBays; b++)
+            {
+                KevDemoBayStats_t stats = manager.getBay(b)->getStats();
+
+                numBits += stats.numBits;
+                numDropped += stats.numDropped;
+            }
+
+            KevDemoWorkStats_t workStats = manager.getWorkStats();
+            manager.close();
+
+            double rate = numBays * numFrames / std::max(wallTime, 1e-9);
+
+            if(baseRate == 0)
+            {
+                baseRate = rate;
+            }
+
+            printf("  %4u  %7u  %8.3f  %8.1f  %6.2fx  %6llu  %7llu  %llu\n",
+                   numBays, manager.getNumWorkers(), wallTime, rate, rate / baseRate,
+                   (unsigned long long)workStats.numSteals, (unsigned long long)numDropped,
+                   (unsigned long long)numBits);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief This function prints the usage of the benchmark.
+ * @param pName program name
+ */
+static void
+printUsage(const char *pName)
+{
+    printf("Usage: %s <benchmark> [options]\n", pName);
+    printf("  diff [iterations]   fused difference kernel vs. OpenCV chain\n");
+    printf("  roi  [iterations]   single-pass ROI sampler vs. cv::mean per ROI\n");
+    printf("  blob [iterations]   connected-component labeler vs. findContours and convexHull\n");
+    printf("  morph [iterations]  van Herk/Gil-Werman morphology vs. cv::dilate and cv::erode\n");
+    printf("  alloc [bursts]      heap allocations per frame of the decoder in steady state\n");
+    printf("  replay <source> [--mi|--rs] [--width N] [--clock K|--clockless] [--manchester] [--hard] [--untracked]\n");
+    printf("         [--threshold T] [--frames N] [--idle-scale N] [--expect bits] [--verbose]\n");
+    printf("                      decode a video file, image sequence, image directory or camera:N as fast\n");
+    printf("                      as possible, and compare with <source>.bits if present\n");
+    printf("  synth [--size WxH] [--width N] [--clock K|--clockless] [--manchester] [--hard] [--untracked]\n");
+    printf("        [--threshold T] [--bits N] [--seed S] [--noise sigma] [--blur sigma] [--flicker amplitude]\n");
+    printf("        [--jitter pixels] [--sway pixels] [--idle-scale N] [--drop probability] [--untimed] [--crop]\n");
+    printf("        [--write dir]\n");
+    printf("                      decode a synthetic LED array and report throughput and bit-error rate\n");
+    printf("  fec [--size WxH] [--width N] [--clock K|--clockless] [--manchester] [--threshold T] [--messages N]\n");
+    printf("      [--bytes N] [--noise s1,s2,...] [--blur sigma] [--flicker amplitude] [--jitter pixels] [--seed S]\n");
+    printf("                      message success and retry latency of uncoded vs. framed bursts\n");
+    printf("  bays [--size WxH] [--width N] [--threshold T] [--frames N] [--bays n1,n2,...]\n");
+    printf("       [--workers n1,n2,...] [--noise sigma]\n");
+    printf("                      aggregate decoding throughput of many bays on a shared work pool\n");
+}
+
+//////////////////////////////////////////////////
+// Main Function Definition
+//////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    if(argc < 2)
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+
+    QString benchmark(argv[1]);
+
+    if(benchmark == "diff")
+    {
+        int iterations = (argc > 2) ? atoi(argv[2]) : KEV_BENCH_NUM_ITERATIONS;
+
+        benchmarkDiffKernel(cv::Size( 640, 480), iterations);
+        benchmarkDiffKernel(cv::Size(1280, 720), iterations);
+    }
+    else if(benchmark == "roi")
+    {
+        int iterations = (argc > 2) ? atoi(argv[2]) : KEV_BENCH_NUM_ITERATIONS;
+
+        benchmarkROISampler(  8, iterations);
+        benchmarkROISampler( 64, iterations);
+        benchmarkROISampler(128, iterations);
+    }
+    else if(benchmark == "blob")
+    {
+        int iterations = (argc > 2) ? atoi(argv[2]) : KEV_BENCH_NUM_ITERATIONS;
+
+        benchmarkBlobLabeler(cv::Size( 640, 480), iterations);
+        benchmarkBlobLabeler(cv::Size(1280, 720), iterations);
+    }
+    else if(benchmark == "morph")
+    {
+        int iterations = (argc > 2) ? atoi(argv[2]) : KEV_BENCH_NUM_ITERATIONS;
+
+        benchmarkMorphology(cv::Size( 640, 480),  5, iterations);
+        benchmarkMorphology(cv::Size( 640, 480),  9, iterations);
+        benchmarkMorphology(cv::Size(1280, 720),  5, iterations);
+        benchmarkMorphology(cv::Size(1280, 720),  9, iterations);
+        benchmarkMorphology(cv::Size(1280, 720), 21, iterations);
+    }
+    else if(benchmark == "alloc")
+    {
+        int bursts = (argc > 2) ? atoi(argv[2]) : KEV_BENCH_NUM_ALLOC_BURSTS;
+
+        if(benchmarkAllocations(cv::Size(640, 480), bursts) == false)
+        {
+            return -2;
+        }
+    }
+    else if(benchmark == "replay" || benchmark == "synth" || benchmark == "fec" || benchmark == "bays")
+    {
+        int result = (benchmark == "replay") ? benchmarkReplay(argc - 2, argv + 2) :
+                     (benchmark == "synth")  ? benchmarkSynth(argc - 2, argv + 2) :
+                     (benchmark == "fec")    ? benchmarkFEC(argc - 2, argv + 2)
+                                             : benchmarkBays(argc - 2, argv + 2);
+
+        if(result == -1)
+        {
+            printUsage(argv[0]);
+        }
+
+        return result;
+    }
+    else
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+
+    return 0;
+}
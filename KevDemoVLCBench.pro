@@ -0,0 +1,89 @@
+#-------------------------------------------------
+#
+# Headless benchmarks of the VLC decoder
+#
+#-------------------------------------------------
+
+QT       += core gui sql
+
+QT += widgets
+
+TARGET = KevDemoVLCBench
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES +=\
+        KevDemoVLCBench.cpp \
+        KevDemoVLCDecoder.cpp \
+        KevDemoVLCReplay.cpp \
+        KevDemoVLCSynth.cpp \
+        KevDemoFrameArena.cpp \
+        KevDemoRSEngine.cpp \
+        KevDemoDiffKernel.cpp \
+        KevDemoROISampler.cpp \
+        KevDemoROIBlock.cpp \
+        KevDemoBlobLabeler.cpp \
+        KevDemoMorphology.cpp \
+        KevDemoActivityDetector.cpp \
+        KevDemoLevelTracker.cpp \
+        KevDemoSymbolClock.cpp \
+        KevDemoSymbolTimer.cpp \
+        KevDemoBitStream.cpp \
+        KevDemoVLCFramer.cpp \
+        KevDemoSoftVoter.cpp \
+        KevDemoROITracker.cpp \
+        KevDemoManchesterDecoder.cpp \
+        KevDemoFrameQueue.cpp \
+        KevDemoFrameRing.cpp \
+        KevDemoCameraPreview.cpp \
+        KevDemoFrameSource.cpp \
+        KevDemoCaptureSource.cpp \
+        KevDemoImageSource.cpp \
+        KevDemoSynthSource.cpp \
+        KevDemoWorkPool.cpp \
+        KevDemoVLCBay.cpp \
+        KevDemoBayManager.cpp
+
+HEADERS  += KevDemoConfig.h \
+            KevDemoVLCDecoder.h \
+            KevDemoVLCReplay.h \
+            KevDemoVLCSynth.h \
+            KevDemoFrameArena.h \
+            KevDemoRSEngine.h \
+            KevDemoDiffKernel.h \
+            KevDemoROISampler.h \
+            KevDemoROIBlock.h \
+            KevDemoBlobLabeler.h \
+            KevDemoMorphology.h \
+            KevDemoActivityDetector.h \
+            KevDemoLevelTracker.h \
+            KevDemoSymbolClock.h \
+            KevDemoSymbolTimer.h \
+            KevDemoBitStream.h \
+            KevDemoVLCFramer.h \
+            KevDemoSoftVoter.h \
+            KevDemoROITracker.h \
+            KevDemoManchesterDecoder.h \
+            KevDemoFrameQueue.h \
+            KevDemoFrameRing.h \
+            KevDemoCameraPreview.h \
+            KevDemoFrameSource.h \
+            KevDemoCaptureSource.h \
+            KevDemoImageSource.h \
+            KevDemoSynthSource.h \
+            KevDemoWorkPool.h \
+            KevDemoVLCBay.h \
+            KevDemoBayManager.h
+
+INCLUDEPATH += /usr/local/include
+
+LIBS += -lopencv_core        \
+        -lopencv_highgui     \
+        -lopencv_video       \
+        -lopencv_imgcodecs   \
+        -lopencv_imgproc     \
+        -lopencv_videoio
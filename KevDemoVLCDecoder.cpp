@@ -1,5 +1,7 @@
 #include "KevDemoVLCDecoder.h"
 
+#include <algorithm>
+
 //////////////////////////////////////////////////
 // Constructor & Destructor Definition
 //////////////////////////////////////////////////
@@ -8,7 +10,8 @@
  * @brief This is a constructor of KevDemoVLCDecoder class
  * @param nDecodeType decoder type
  */
-KevDemoVLCDecoder::KevDemoVLCDecoder(int nDecodeType)
+KevDemoVLCDecoder::KevDemoVLCDecoder(int nDecodeType) :
+    m_rFrameArena(KEV_VLC_FRAME_RING_SIZE, KEV_VLC_NUM_SCRATCHES)
 {
     m_rPrevFrame = cv::Mat();
     m_nDecodeType = nDecodeType;
@@ -17,8 +20,19 @@ KevDemoVLCDecoder::KevDemoVLCDecoder(int nDecodeType)
     m_rDetectedROIs.clear();
     m_nNumConsEmptyFrames = 0;
     m_nFrameCounter = 0;
+    m_nNumMissedFrames = 0;
+    m_nNumBgrdFrames = 0;
+    m_bIsPrevCropped = false;
     m_nDataWidth = 0;
     m_nClockIndex = 0;
+    m_bIsRelocked = false;
+    m_nNumSyncFramesLeft = 0;
+    m_bIsClockless = false;
+    m_bIsFramed = false;
+    m_bIsSoftDecision = true;
+    m_bIsVoting = false;
+    m_bIsTracking = true;
+    m_bIsManchester = false;
 }
 
 /**
@@ -27,6 +41,7 @@ KevDemoVLCDecoder::KevDemoVLCDecoder(int nDecodeType)
 KevDemoVLCDecoder::~KevDemoVLCDecoder()
 {
     m_rPrevFrame.release();
+    m_rFrameArena.release();
 }
 
 //////////////////////////////////////////////////
@@ -41,27 +56,133 @@ KevDemoVLCDecoder::~KevDemoVLCDecoder()
  */
 KevDemoError_t
 KevDemoVLCDecoder::decode(cv::Mat& rCurrFrame, std::vector<int>& rDecodedBits)
+{
+    m_rBitStream.clear();
+
+    KevDemoError_t error = decode(rCurrFrame, m_rBitStream);
+    m_rBitStream.unpack(rDecodedBits);
+
+    return error;
+}
+
+/**
+ * @brief This function is used to decode a frame using a specifc type of decoder.
+ *        Each MIMO data burst, or each Rolling Shutter data frame, ends a frame of
+ *        the bit stream. In framed mode, a frame of the bit stream is the payload of a
+ *        frame of KevDemoVLCFramer passing its CRC. A frame without a timestamp takes
+ *        the next frame slot, so no frame is regarded as missed.
+ * @param rCurrFrame the current frame to be decoded
+ * @param rBitStream decoded output bits are appended with their confidences
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCDecoder::decode(cv::Mat& rCurrFrame, KevDemoBitStream& rBitStream)
+{
+    m_rSymbolTimer.advance();
+    m_nNumMissedFrames = 0;
+
+    return decodeFrame(rCurrFrame, cv::Rect(), rBitStream);
+}
+
+/**
+ * @brief This function is used to decode a timestamped frame using a specifc type of decoder.
+ * @param rCurrFrame the current frame to be decoded
+ * @param rDecodedBits decoded output bits
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCDecoder::decode(KevDemoFrame_t& rCurrFrame, std::vector<int>& rDecodedBits)
+{
+    m_rBitStream.clear();
+
+    KevDemoError_t error = decode(rCurrFrame, m_rBitStream);
+    m_rBitStream.unpack(rDecodedBits);
+
+    return error;
+}
+
+/**
+ * @brief This function is used to decode a timestamped frame using a specifc type of decoder.
+ *        The SYNC and DATA states are scheduled on the frame slots of the timestamps, so
+ *        the slots of missed frames count towards the sync and data frames, and the
+ *        symbols lost in them are erased, while a duplicated frame is skipped. A cropped
+ *        frame is decoded only in the data frames and if it covers the ROI blocks, and
+ *        is skipped as a missed frame otherwise, e.g. when captured before the crop
+ *        is released at the end of a burst.
+ * @param rCurrFrame the current frame to be decoded
+ * @param rBitStream decoded output bits are appended with their confidences
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCDecoder::decode(KevDemoFrame_t& rCurrFrame, KevDemoBitStream& rBitStream)
+{
+    if(rCurrFrame.region.area() > 0)
+    {
+        cv::Rect roiRegion = getROIRegion();
+
+        if(m_nVLCState != KEV_VLC_STATE_DATA || roiRegion.area() <= 0 ||
+           (rCurrFrame.region & roiRegion) != roiRegion)
+        {
+            return KEV_SUCCESS;
+        }
+    }
+
+    int32_t numMissed = m_rSymbolTimer.advance(rCurrFrame.timestamp);
+
+    if(numMissed < 0)
+    {
+        return KEV_SUCCESS;
+    }
+
+    m_nNumMissedFrames = numMissed;
+
+    return decodeFrame(rCurrFrame.image, rCurrFrame.region, rBitStream);
+}
+
+/**
+ * @brief This function decodes a frame placed on its frame slot.
+ * @param rCurrFrame the current frame to be decoded
+ * @param rRegion region of the pixels of the current frame (an empty rect for all)
+ * @param rBitStream decoded output bits are appended with their confidences
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCDecoder::decodeFrame(cv::Mat& rCurrFrame, cv::Rect rRegion, KevDemoBitStream& rBitStream)
 {
     if(m_rPrevFrame.empty() == true)
     {
-        m_rPrevFrame = rCurrFrame.clone();
+        m_rPrevFrame = m_rFrameArena.pushFrame(rCurrFrame);
         return KEV_SUCCESS;
     }
 
     // IDLE state check
     if(isIdleDetected())
     {
+        // a burst cut short still ends its frame
+        if(m_nVLCState == KEV_VLC_STATE_DATA)
+        {
+            endBurst(rBitStream);
+        }
+
         m_nVLCState = KEV_VLC_STATE_IDLE;
         m_nNumConsEmptyFrames = 0;
         m_nFrameCounter = 0;
     }
 
+    // a burst cut short leaves only the ROI blocks of the previous frame
+    if(m_bIsPrevCropped == true && m_nVLCState != KEV_VLC_STATE_DATA)
+    {
+        m_rPrevFrame = m_rFrameArena.pushFrame(rCurrFrame);
+        m_bIsPrevCropped = false;
+        return KEV_SUCCESS;
+    }
+
     // VLC state machine
     switch(m_nVLCState)
     {
         case KEV_VLC_STATE_IDLE:
         {
-            m_rDetectedROIs.clear();
+            m_rRSEngine.reset();
 
             // try to detect a sync start frame
             if(detectSyncStart(rCurrFrame) == true)
@@ -73,35 +194,109 @@ KevDemoVLCDecoder::decode(cv::Mat& rCurrFrame, std::vector<int>& rDecodedBits)
         }
         case KEV_VLC_STATE_SYNC:
         {
+            // the sync frames end on time even if some of them are missed
+            m_nFrameCounter += m_nNumMissedFrames;
+
             // detects ROI blocks for VLC
             if(detectROIs(rCurrFrame, m_rDetectedROIs) == true)
             {
                 m_nVLCState = KEV_VLC_STATE_DATA;
                 m_nFrameCounter = 0;
                 m_rPrevClock = 0;
+                m_rSymbolClock.reset();
+                m_rSoftVoter.clear();
+                m_bIsVoting = false;
+                m_rManchester.reset(m_rROISampler.getSums());
+                m_rSymbolTimer.resetSymbols();
+                m_rSymbolStream.clear();
             }
             break;
         }
         case KEV_VLC_STATE_DATA:
         {
-            std::vector<int> decodedSignals;
+            std::vector<int> &decodedSignals = m_rDecodedSignals;
+
+            // bits of a frame are collected to be decoded as a whole in framed mode
+            KevDemoBitStream &dataStream = (m_bIsFramed == true) ? m_rFrameBits : rBitStream;
+
+            // the sync frames sent after a re-lock are skipped until the LEDs stop toggling,
+            // and the missed ones are counted by their slots
+            if(m_nNumSyncFramesLeft > 0 && isSyncFrameLeft(rCurrFrame) == true)
+            {
+                m_nNumSyncFramesLeft -= std::min<uint32_t>(m_nNumSyncFramesLeft, 1 + m_nNumMissedFrames);
+                m_rManchester.reset(m_rROISampler.getSums());
+                break;
+            }
+
+            m_nNumSyncFramesLeft = 0;
 
             // decode a data frame
-            decodeDataFrame(rCurrFrame, decodedSignals);
+            KevDemoError_t error = decodeDataFrame(rCurrFrame, decodedSignals);
+
+            // a Manchester symbol is decided after its mid-symbol transition, which may be
+            // observed in the last data frame of a burst
+            if(error == KEV_SUCCESS && m_nDecodeType == KEV_VLC_DEC_MI && m_bIsManchester == true)
+            {
+                m_rManchester.push(m_nClockIndex, m_rSymbolStream);
+                appendSymbols(dataStream);
+
+                // a symbol is marked at the last frame of its mid-symbol clock transition
+                if(m_nClockIndex < m_rManchester.getDeltas().size() &&
+                   m_rManchester.getDeltas()[m_nClockIndex] < 0)
+                {
+                    m_rSymbolTimer.markSymbol();
+                }
+            }
+
+            // the data frames end on time, so a missed frame does not shift the next burst
+            m_nFrameCounter += m_nNumMissedFrames;
 
             if(++m_nFrameCounter >= KEV_VLC_NUM_DATA_FRAMES)
             {
+                endBurst(rBitStream);
+
                 m_nVLCState = KEV_VLC_STATE_IDLE;
                 m_nFrameCounter = 0;
             }
-            else
+            else if(error == KEV_SUCCESS && m_nDecodeType == KEV_VLC_DEC_RS)
+            {
+                // a Rolling Shutter frame carries whole packets without a clock LED
+                for(uint32_t i = 0; i < decodedSignals.size(); i++)
+                {
+                    dataStream.append(decodedSignals[i], m_rDecodedConfidences[i]);
+                }
+
+                closeFrame(rBitStream);
+            }
+            else if(error == KEV_SUCCESS && m_bIsManchester == false && m_bIsClockless == true)
+            {
+                // return decoded bits of the symbols whose boundaries are recovered from
+                // the transitions of the data LEDs, at the slot time of this frame
+                m_rSymbolClock.push(m_rSymbolTimer.getFrameTime(), decodedSignals,
+                                    m_rDecodedConfidences, dataStream);
+            }
+            else if(error == KEV_SUCCESS && m_bIsManchester == false &&
+                    decodedSignals.size() > m_nClockIndex)
             {
 #if 1
-                // return decoded bits at clock rising edge
+                // return decoded bits at clock rising edge, which may be hidden by missed frames
                 int currClock = decodedSignals[m_nClockIndex];
+                bool isRising = (currClock == 1 &&
+                                 (m_rPrevClock == 0 || (m_nNumMissedFrames > 0 && m_rSymbolTimer.isSymbolDue() == true)));
+
+                if(isRising == true && m_bIsSoftDecision == true)
+                {
+                    // the symbol of the previous rising edge ends before this frame
+                    emitVotes(m_rSymbolStream);
+                    appendSymbols(dataStream);
 
-                if(currClock != m_rPrevClock && currClock == 1)
+                    m_rSymbolTimer.markSymbol();
+                    m_bIsVoting = true;
+                }
+                else if(isRising == true)
                 {
+                    m_rSymbolTimer.markSymbol();
+
                     for(uint32_t i = 0; i < decodedSignals.size(); i++)
                     {
                         if(i == m_nClockIndex)
@@ -109,15 +304,23 @@ KevDemoVLCDecoder::decode(cv::Mat& rCurrFrame, std::vector<int>& rDecodedBits)
                             continue;
                         }
 
-                        rDecodedBits.push_back(decodedSignals[i]);
+                        m_rSymbolStream.append(decodedSignals[i], m_rDecodedConfidences[i]);
                     }
+
+                    appendSymbols(dataStream);
+                }
+
+                // every frame of a symbol votes for its bits
+                if(m_bIsVoting == true)
+                {
+                    m_rSoftVoter.vote(m_rDecodedSoftValues);
                 }
 
                 m_rPrevClock = currClock;
 #else
                 for(uint32_t i = 0; i < decodedSignals.size(); i++)
                 {
-                    rDecodedBits.push_back(decodedSignals[i]);
+                    dataStream.append(decodedSignals[i], m_rDecodedConfidences[i]);
                 }
 #endif
             }
@@ -127,32 +330,197 @@ KevDemoVLCDecoder::decode(cv::Mat& rCurrFrame, std::vector<int>& rDecodedBits)
             return KEV_ERROR_UNKNOWN_VLC_STATE;
     }
 
-    // update the previous frame
-    m_rPrevFrame = rCurrFrame.clone();
+    // update the previous frame by reusing the oldest buffer of the frame ring. No pixels
+    // out of the ROI blocks are read until a burst ends, so only they are retained.
+    m_bIsPrevCropped = (m_nVLCState == KEV_VLC_STATE_DATA || rRegion.area() > 0);
+    m_rPrevFrame = (m_bIsPrevCropped == true) ? m_rFrameArena.pushFrame(rCurrFrame, getROIRegion()) :
+                                                m_rFrameArena.pushFrame(rCurrFrame);
 
-    // draw a red rectangle over the current frmae for each blob
-    for(KevDemoROIBlock &block : m_rDetectedROIs)
+    // draw a red rectangle over the current frmae for each blob while the ROIs are locked.
+    // The ROI blocks are kept over the other states to reuse their buffers.
+    for(uint32_t i = 0; m_nVLCState == KEV_VLC_STATE_DATA && i < m_rDetectedROIs.size(); i++)
     {
-        cv::rectangle(rCurrFrame, block.getBoundingRect(), COLOR_WHITE, 1);
+        cv::rectangle(rCurrFrame, m_rDetectedROIs[i].getBoundingRect(), COLOR_WHITE, 1);
     }
 
     return KEV_SUCCESS;
 }
 
+/**
+ * @brief This function returns the region of the next frames read by the data frames
+ *        of a burst, i.e. the ROI blocks with a margin to move in. The next frames may
+ *        be cropped to the region, which is empty unless the frames are to be cropped.
+ * @return the data region, or an empty rect for the whole frames
+ */
+cv::Rect
+KevDemoVLCDecoder::getDataRegion()
+{
+    // the last data frames are captured as a whole for the sync frames of the next burst
+    if(m_nVLCState != KEV_VLC_STATE_DATA ||
+       m_nFrameCounter + KEV_VLC_CROP_LEAD_FRAMES >= KEV_VLC_NUM_DATA_FRAMES)
+    {
+        return cv::Rect();
+    }
+
+    cv::Rect region = getROIRegion();
+
+    if(region.area() <= 0)
+    {
+        return cv::Rect();
+    }
+
+    region = cv::Rect(region.x - KEV_VLC_CROP_MARGIN, region.y - KEV_VLC_CROP_MARGIN,
+                      region.width + 2 * KEV_VLC_CROP_MARGIN, region.height + 2 * KEV_VLC_CROP_MARGIN);
+
+    return region & cv::Rect(0, 0, m_rPrevFrame.cols, m_rPrevFrame.rows);
+}
+
+/**
+ * @brief This function returns the region of the pixels read around the ROI blocks in
+ *        a data frame, which covers the windows of the ROI tracker.
+ * @return the bounding box of the ROI blocks and their margins in the frame
+ */
+cv::Rect
+KevDemoVLCDecoder::getROIRegion()
+{
+    cv::Rect region;
+
+    for(KevDemoROIBlock &block : m_rDetectedROIs)
+    {
+        region = (region.area() <= 0) ? block.getBoundingRect() : (region | block.getBoundingRect());
+    }
+
+    if(region.area() <= 0)
+    {
+        return cv::Rect();
+    }
+
+    region = cv::Rect(region.x - KEV_ROI_TRACKER_MARGIN, region.y - KEV_ROI_TRACKER_MARGIN,
+                      region.width + 2 * KEV_ROI_TRACKER_MARGIN, region.height + 2 * KEV_ROI_TRACKER_MARGIN);
+
+    return region & cv::Rect(0, 0, m_rPrevFrame.cols, m_rPrevFrame.rows);
+}
+
+/**
+ * @brief This function ends a MIMO data burst, emitting the last symbol of a clockless
+ *        burst, and ends the frame of the bit stream.
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoVLCDecoder::endBurst(KevDemoBitStream& rBitStream)
+{
+    if(m_nDecodeType != KEV_VLC_DEC_MI)
+    {
+        return;
+    }
+
+    KevDemoBitStream &dataStream = (m_bIsFramed == true) ? m_rFrameBits : rBitStream;
+
+    // the last symbol of a burst ends with its data frames
+    if(m_bIsManchester == true)
+    {
+        m_rManchester.flush(m_nClockIndex, m_rSymbolStream);
+        appendSymbols(dataStream);
+    }
+    else if(m_bIsClockless == true)
+    {
+        m_rSymbolClock.flush(dataStream);
+    }
+    else
+    {
+        emitVotes(m_rSymbolStream);
+        appendSymbols(dataStream);
+        m_bIsVoting = false;
+    }
+
+    closeFrame(rBitStream);
+}
+
+/**
+ * @brief This function decides the bits of the voted symbol, if any, and appends them
+ *        except for the clock LED.
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoVLCDecoder::emitVotes(KevDemoBitStream& rBitStream)
+{
+    if(m_rSoftVoter.getNumVotes() == 0)
+    {
+        return;
+    }
+
+    m_rSoftVoter.decide(m_rVotedSignals, m_rVotedConfidences);
+    m_rSoftVoter.clear();
+
+    for(uint32_t i = 0; i < m_rVotedSignals.size(); i++)
+    {
+        if(i == m_nClockIndex)
+        {
+            continue;
+        }
+
+        rBitStream.append(m_rVotedSignals[i], m_rVotedConfidences[i]);
+    }
+}
+
+/**
+ * @brief This function appends the bits of the symbols decided by the current frame at
+ *        the time of their mark, after the erasures of the symbols lost in missed frames.
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoVLCDecoder::appendSymbols(KevDemoBitStream& rBitStream)
+{
+    m_rSymbolTimer.appendSymbol(m_rSymbolStream, rBitStream);
+    m_rSymbolStream.clear();
+}
+
+/**
+ * @brief This function ends a frame of the bit stream. In framed mode, the collected
+ *        bits of the frame are decoded, correcting bit errors in place, and only the
+ *        payload of a frame passing its CRC is output.
+ * @param rBitStream decoded output bits
+ */
+void
+KevDemoVLCDecoder::closeFrame(KevDemoBitStream& rBitStream)
+{
+    if(m_bIsFramed == false)
+    {
+        rBitStream.endFrame();
+        return;
+    }
+
+    KevDemoError_t error = m_rFramer.decode(m_rFrameBits, m_rFramePayload);
+
+    m_rFrameBits.clear();
+
+    if(error != KEV_SUCCESS)
+    {
+#ifdef KEV_VLC_DEC_DEBUG_ENABLE
+        emit sig_printDebugMessage(QString("> Frame rejected: %1").arg(error));
+#endif
+        return;
+    }
+
+    rBitStream.append(m_rFramePayload);
+    rBitStream.endFrame();
+}
+
 /**
  * @brief This function is used to decode a frame using a specifc type of decoder.
  * @param rCurrFrame the current frame to be decoded
  * @param rBlobs a list of detected blobs
+ * @param rRegion a region of the frame to be searched (empty for the whole frame)
  * @return error information
  */
 KevDemoError_t
-KevDemoVLCDecoder::decodeSyncFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs)
+KevDemoVLCDecoder::decodeSyncFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs, cv::Rect rRegion)
 {
     KevDemoError_t error;
 
     if(m_nDecodeType == KEV_VLC_DEC_MI)
     {
-        error = decodeSyncMIFrame(rCurrFrame, rBlobs);
+        error = decodeSyncMIFrame(rCurrFrame, rBlobs, rRegion);
     }
     else if(m_nDecodeType == KEV_VLC_DEC_RS)
     {
@@ -170,23 +538,39 @@ KevDemoVLCDecoder::decodeSyncFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBl
  * @brief This function decodes a sync frame using MIMO decoder.
  * @param rCurrFrame the current frame to be decoded
  * @param rBlobs a list of detected ROI blocks
+ * @param rRegion a region of the frame to be searched (empty for the whole frame)
  * @return error information
  */
 KevDemoError_t
-KevDemoVLCDecoder::decodeSyncMIFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs)
+KevDemoVLCDecoder::decodeSyncMIFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs, cv::Rect rRegion)
 {
     KevDemoError_t error = KEV_SUCCESS;
 
-    cv::Mat diffFrame;
+    cv::Mat &diffFrame = m_rFrameArena.getScratch(KEV_VLC_SCRATCH_DIFF, rCurrFrame.size(), CV_8UC1);
+    cv::Rect frameRect(0, 0, rCurrFrame.cols, rCurrFrame.rows);
+
+    rRegion &= frameRect;
+
+    // nothing outside the region is searched
+    if(rRegion.area() <= 0)
+    {
+        rRegion = frameRect;
+    }
+    else if(rRegion != frameRect)
+    {
+        diffFrame.setTo(cv::Scalar(0));
+    }
+
+    cv::Mat diffRegion(diffFrame, rRegion);
 
     // obtain the difference of the current and previous frames
-    if((error = obtainDiffFrame(m_rPrevFrame, rCurrFrame, diffFrame)) != KEV_SUCCESS)
+    if((error = obtainDiffFrame(m_rPrevFrame(rRegion), rCurrFrame(rRegion), diffRegion)) != KEV_SUCCESS)
     {
         return error;
     }
 
     // perform morphology filtering
-    if((error = filterMorphology(diffFrame, 5)) != KEV_SUCCESS)
+    if((error = filterMorphology(diffRegion, 5)) != KEV_SUCCESS)
     {
         return error;
     }
@@ -211,42 +595,63 @@ KevDemoVLCDecoder::decodeSyncRSFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& r
 {
     KevDemoError_t error = KEV_SUCCESS;
 
-    // Rolling Shutter Algorithm
+    if(rCurrFrame.empty() == true)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
 
-    return error;
-}
+    cv::Mat &brightFrame = m_rFrameArena.getScratch(KEV_VLC_SCRATCH_DIFF, rCurrFrame.size(), CV_8UC1);
 
+    // thresholding the current frame into a black & white image of the lit bands
+    cv::threshold(rCurrFrame, brightFrame, m_nThreshold, 255, CV_THRESH_BINARY);
 
-/**
- * @brief This function is used to subtract the previous frame with the current frame.
- * @param rPrevFrame a previous frame
- * @param rCurrFrame a current frame
- * @param rDiffFrame a result substract frame
- * @return error information
- */
-KevDemoError_t
-KevDemoVLCDecoder::subtractFrame(cv::Mat rPrevFrame, cv::Mat rCurrFrame, cv::Mat &rSubFrame)
-{
-    if(rPrevFrame.empty() == true || rCurrFrame.empty() == true)
+    // merge the bands of a LED into a single region
+    if((error = filterMorphology(brightFrame, KEV_VLC_RS_FILTER_SIZE)) != KEV_SUCCESS)
     {
-        return KEV_ERROR_INVALID_ARGUMENTS;
+        return error;
+    }
+
+    std::vector<VLCBlob> &candidates = m_rCandidateBlobs;
+
+    if((error = detectBlobs(brightFrame, candidates)) != KEV_SUCCESS)
+    {
+        return error;
     }
 
-    cv::GaussianBlur(rPrevFrame, rPrevFrame, cv::Size(5, 5), 0);
-    cv::GaussianBlur(rCurrFrame, rCurrFrame, cv::Size(5, 5), 0);
+    // select the largest region showing enough bands
+    rBlobs.clear();
+    int selected = -1;
 
-    // obtain a substraction image
-    cv::subtract(rPrevFrame, rCurrFrame, rSubFrame);
+    for(uint32_t i = 0; i < candidates.size(); i++)
+    {
+        if(m_rRSEngine.extractProfile(rCurrFrame, candidates[i].boundingRect) != KEV_SUCCESS ||
+           m_rRSEngine.detectEdges() < KEV_VLC_RS_MIN_EDGES)
+        {
+            continue;
+        }
 
-    // thresholding the substract image into a black & white image
-    cv::threshold(rSubFrame, rSubFrame, m_nThreshold, 255, CV_THRESH_BINARY);
+        if(selected < 0 || candidates[i].boundingRect.area() > candidates[selected].boundingRect.area())
+        {
+            selected = i;
+        }
+    }
 
-#ifdef KEV_VLC_DEC_DEBUG_ENABLE
-    cv::imshow("subtractFrame", rSubFrame);
-#endif
-    return KEV_SUCCESS;
+    if(selected < 0)
+    {
+        return error;
+    }
+
+    // train the symbol clock with the bands of the selected region
+    m_rRSEngine.extractProfile(rCurrFrame, candidates[selected].boundingRect);
+    m_rRSEngine.detectEdges();
+    m_rRSEngine.trainClock(m_nDataWidth);
+
+    rBlobs.push_back(candidates[selected]);
+
+    return error;
 }
 
+
 /**
  * @brief This function is used to obtain the difference of the current frame from its previous frame.
  * @param rPrevFrame a previous frame
@@ -255,22 +660,17 @@ KevDemoVLCDecoder::subtractFrame(cv::Mat rPrevFrame, cv::Mat rCurrFrame, cv::Mat
  * @return error information
  */
 KevDemoError_t
-KevDemoVLCDecoder::obtainDiffFrame(cv::Mat rPrevFrame, cv::Mat rCurrFrame, cv::Mat &rDiffFrame)
+KevDemoVLCDecoder::obtainDiffFrame(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame, cv::Mat &rDiffFrame)
 {
-    if(rPrevFrame.empty() == true || rCurrFrame.empty() == true)
+    // blur both frames, obtain their difference and threshold it into a black & white image
+    // in a single pass, without modifying the previous and current frames
+    KevDemoError_t error = m_rDiffKernel.apply(rPrevFrame, rCurrFrame, rDiffFrame, m_nThreshold);
+
+    if(error != KEV_SUCCESS)
     {
-        return KEV_ERROR_INVALID_ARGUMENTS;
+        return error;
     }
 
-    cv::GaussianBlur(rPrevFrame, rPrevFrame, cv::Size(5, 5), 0);
-    cv::GaussianBlur(rCurrFrame, rCurrFrame, cv::Size(5, 5), 0);
-
-    // obtain a difference image
-    cv::absdiff(rPrevFrame, rCurrFrame, rDiffFrame);
-
-    // thresholding the difference image into a black & white image
-    cv::threshold(rDiffFrame, rDiffFrame, m_nThreshold, 255, CV_THRESH_BINARY);
-
 #ifdef KEV_VLC_DEC_DEBUG_ENABLE
     cv::imshow("obtainDiffFrame", rDiffFrame);
 #endif
@@ -291,12 +691,13 @@ KevDemoVLCDecoder::filterMorphology(cv::Mat &rFrame, int nFilterSize)
         return KEV_ERROR_INVALID_ARGUMENTS;
     }
 
-    cv::Size filterSize(nFilterSize, nFilterSize);
-    cv::Mat filterElement = cv::getStructuringElement(cv::MORPH_RECT, filterSize);
+    // dilate twice and then erode, in constant time per pixel of any filter size
+    KevDemoError_t error = m_rMorphology.filter(rFrame, nFilterSize);
 
-    cv::dilate(rFrame, rFrame, filterElement);
-    cv::dilate(rFrame, rFrame, filterElement);
-    cv::erode( rFrame, rFrame, filterElement);
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
 
 #ifdef KEV_VLC_DEC_DEBUG_ENABLE
     cv::imshow("filterMorphology", rFrame);
@@ -321,35 +722,42 @@ KevDemoVLCDecoder::detectBlobs(cv::Mat rFrame, std::vector<VLCBlob> &rBlobs)
     // clear a list of blobs
     rBlobs.clear();
 
-    // find contours
-    std::vector<std::vector<cv::Point> > contours;
-    cv::findContours(rFrame, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
-
-    // find convex hulls
-    std::vector<std::vector<cv::Point> > convexHulls(contours.size());
+    // label connected components with their bounding boxes in a single pass
+    KevDemoError_t error = m_rBlobLabeler.label(rFrame);
 
-    for(uint32_t i = 0; i < contours.size(); i++)
+    if(error != KEV_SUCCESS)
     {
-        cv::convexHull(contours[i], convexHulls[i]);
+        return error;
     }
 
-    // add ROI blocks to the given block list
-    for(auto &convexHull : convexHulls)
-    {
-        VLCBlob blob(convexHull);
+    // reject components by their bounding boxes before building any contour
+    const std::vector<KevDemoBlobLabeler::BlobStats_t> &components = m_rBlobLabeler.getComponents();
+
+    m_rSelectedBlobs.clear();
 
-        if(blob.isValid() == true)
+    for(uint32_t i = 0; i < components.size(); i++)
+    {
+        if(VLCBlob::isValidRect(components[i].boundingRect, m_nDecodeType) == true)
         {
-            rBlobs.push_back(blob);
+            m_rSelectedBlobs.push_back(i);
         }
     }
 
+    // build convex hulls only for the valid components
+    m_rBlobLabeler.buildHulls(m_rSelectedBlobs, m_rBlobHulls);
+
+    // add ROI blocks to the given block list, which refer to the hulls without a copy
+    for(uint32_t i = 0; i < m_rSelectedBlobs.size(); i++)
+    {
+        rBlobs.push_back(VLCBlob(m_rBlobHulls[i]));
+    }
+
 #ifdef KEV_VLC_DEC_DEBUG_ENABLE
     cv::Mat imgConvexHulls(rFrame.size(), CV_8UC3, COLOR_BLACK);
     // to draw only the valid convex hulls
-    convexHulls.clear();
+    std::vector<std::vector<cv::Point> > convexHulls;
     for (auto &blob : rBlobs) {
-        convexHulls.push_back(blob.contour);
+        convexHulls.push_back(*blob.contour);
     }
     cv::drawContours(imgConvexHulls, convexHulls, -1, COLOR_WHITE, -1);
     cv::imshow("imgConvexHulls", imgConvexHulls);
@@ -357,6 +765,39 @@ KevDemoVLCDecoder::detectBlobs(cv::Mat rFrame, std::vector<VLCBlob> &rBlobs)
     return KEV_SUCCESS;
 }
 
+/**
+ * @brief This function sorts blobs in reading order, from top to bottom and from left
+ *        to right. Blobs whose centers are within half a blob height of the first blob
+ *        of a row are regarded as the same row.
+ * @param rBlobs blobs to be sorted
+ */
+void
+KevDemoVLCDecoder::sortBlobs(std::vector<VLCBlob>& rBlobs)
+{
+    std::sort(rBlobs.begin(), rBlobs.end(), [](const VLCBlob& rA, const VLCBlob& rB) {
+        return rA.centerPosition.y < rB.centerPosition.y;
+    });
+
+    auto rowStart = rBlobs.begin();
+
+    while(rowStart != rBlobs.end())
+    {
+        auto rowEnd = rowStart + 1;
+
+        while(rowEnd != rBlobs.end() &&
+              rowEnd->centerPosition.y - rowStart->centerPosition.y <= rowStart->boundingRect.height / 2)
+        {
+            rowEnd++;
+        }
+
+        std::sort(rowStart, rowEnd, [](const VLCBlob& rA, const VLCBlob& rB) {
+            return rA.centerPosition.x < rB.centerPosition.x;
+        });
+
+        rowStart = rowEnd;
+    }
+}
+
 /**
  * @brief This function detects VLC sync start frame.
  * @param rFrame an image frame
@@ -365,12 +806,22 @@ KevDemoVLCDecoder::detectBlobs(cv::Mat rFrame, std::vector<VLCBlob> &rBlobs)
 bool
 KevDemoVLCDecoder::detectSyncStart(cv::Mat rFrame)
 {
-    std::vector<VLCBlob> blobs;
+    std::vector<VLCBlob> &blobs = m_rBlobs;
+    cv::Rect region;
+
+    // nothing is transmitted most of the time, so look for changes on a coarse level
+    // first and search the full resolution frame only around them
+    if(m_nDecodeType == KEV_VLC_DEC_MI &&
+       m_rActivityDetector.detect(m_rPrevFrame, rFrame, m_nThreshold, region) == false)
+    {
+        m_nNumConsEmptyFrames++;
+        return false;
+    }
 
     // find blobs from the current frame
-    KevDemoError_t error = decodeSyncFrame(rFrame, blobs);
+    KevDemoError_t error = decodeSyncFrame(rFrame, blobs, region);
 
-    if(error != KEV_SUCCESS || blobs.size() != m_nDataWidth)
+    if(error != KEV_SUCCESS || blobs.size() != getNumSyncBlobs())
     {
         m_nNumConsEmptyFrames++;
         return false;
@@ -380,12 +831,21 @@ KevDemoVLCDecoder::detectSyncStart(cv::Mat rFrame)
         m_nNumConsEmptyFrames = 0;
     }
 
-    // create a background frame
-    m_rBgrdFrame = cv::Mat::zeros(rFrame.size(), CV_32FC1);
+    // the coarse level of this frame is stale once the IDLE state is left
+    m_rActivityDetector.reset();
 
-    // create a sync frame by drawing blobs on a black frame
-    m_rSyncFrame = cv::Mat::zeros(rFrame.size(), CV_32FC3);
-    drawBlobsToFrame(m_rSyncFrame, blobs);
+    // the ROIs need not be accumulated again if the last layout is found at the blobs
+    m_bIsRelocked = matchLastROIs(blobs, rFrame.size());
+
+    // clear the sum of the background
+    m_rBgrdFrame = m_rFrameArena.getScratch(KEV_VLC_SCRATCH_BGRD, rFrame.size(), CV_16UC1);
+    m_rBgrdFrame.setTo(COLOR_BLACK);
+    m_nNumBgrdFrames = 0;
+
+    // start the votes of the sync frames with the blobs of the sync start frame
+    m_rSyncFrame = m_rFrameArena.getScratch(KEV_VLC_SCRATCH_SYNC, rFrame.size(), CV_16UC1);
+    m_rSyncFrame.setTo(COLOR_BLACK);
+    voteBlobs(blobs);
 
     emit sig_printDebugMessage(QString("Sync Start..."));
 
@@ -409,9 +869,51 @@ KevDemoVLCDecoder::detectROIs(cv::Mat rSyncFrame, std::vector<KevDemoROIBlock> &
         return false;
     }
 
-    // decode a sync frame
-    std::vector<VLCBlob> blobs;
-    KevDemoError_t error = decodeSyncFrame(rSyncFrame, blobs);
+    std::vector<VLCBlob> &blobs = m_rBlobs;
+    KevDemoError_t error;
+
+    // the last ROI layout is re-locked once the blobs of a few sync frames stay at its
+    // offset, and the ROIs are accumulated over the rest of the sync frames otherwise
+    if(m_bIsRelocked == true)
+    {
+        cv::Point offset = m_rRelockOffset;
+
+        error = decodeSyncFrame(rSyncFrame, blobs);
+
+        if(error == KEV_SUCCESS && matchLastROIs(blobs, rSyncFrame.size()) == true &&
+           std::abs(m_rRelockOffset.x - offset.x) <= KEV_VLC_RELOCK_TOLERANCE &&
+           std::abs(m_rRelockOffset.y - offset.y) <= KEV_VLC_RELOCK_TOLERANCE)
+        {
+            m_nNumConsEmptyFrames = 0;
+
+            cv::add(m_rBgrdFrame, rSyncFrame, m_rBgrdFrame, cv::noArray(), CV_16U);
+            m_nNumBgrdFrames++;
+            m_rRelockOffset = offset;
+            m_nFrameCounter++;
+
+            // only the received sync frames verify the layout
+            if(m_nNumBgrdFrames >= KEV_VLC_RELOCK_FRAMES)
+            {
+                relockROIs(rROIBlocks);
+                trainLevels(rSyncFrame);
+
+                // take the LED states of the last sync frame
+                isSyncFrameLeft(rSyncFrame);
+                return true;
+            }
+
+            return false;
+        }
+
+        m_bIsRelocked = false;
+        m_rRelockOffset = offset;
+        emit sig_printDebugMessage(QString("ROI Re-lock Failed."));
+    }
+    else
+    {
+        // decode a sync frame
+        error = decodeSyncFrame(rSyncFrame, blobs);
+    }
 
     if(error != KEV_SUCCESS)
     {
@@ -423,49 +925,56 @@ KevDemoVLCDecoder::detectROIs(cv::Mat rSyncFrame, std::vector<KevDemoROIBlock> &
         m_nNumConsEmptyFrames = 0;
     }
 
-    cv::Mat syncFrame(rSyncFrame.size(), CV_8UC3, COLOR_BLACK);
-    drawBlobsToFrame(syncFrame, blobs);
-
     // accumulate sync frames to build a background frame
-    cv::accumulate(rSyncFrame, m_rBgrdFrame);
+    cv::add(m_rBgrdFrame, rSyncFrame, m_rBgrdFrame, cv::noArray(), CV_16U);
+    m_nNumBgrdFrames++;
 
-    // accumulate sync frames to detect ROIs
-    cv::accumulate(syncFrame, m_rSyncFrame);
+    // accumulate the votes of the blobs to detect ROIs
+    voteBlobs(blobs);
 
     // if all the sync frames are received, find ROI blocks and change the state into KEV_DEMO_STATE_DATA.
-    if(++m_nFrameCounter >= KEV_VLC_NUM_SYNC_FRAMES)
+    if(++m_nFrameCounter >= getNumSyncFrames())
     {
-        cv::Mat roiFrame;
-        cv::cvtColor(m_rSyncFrame, syncFrame, CV_RGB2GRAY);
-        syncFrame.convertTo(roiFrame, CV_8UC1);
+        // a pixel voted by any sync frame belongs to a ROI
+        cv::Mat &roiFrame = m_rFrameArena.getScratch(KEV_VLC_SCRATCH_ROI, rSyncFrame.size(), CV_8UC1);
+        m_rSyncFrame.convertTo(roiFrame, CV_8UC1);
 
         // detect blobs of the accumulated sync frame
         error = detectBlobs(roiFrame, blobs);
 
-        // return false if the number of detected blobs of a sync frame is different from the data width
-        if(error != KEV_SUCCESS || blobs.size() != m_nDataWidth)
+        // return false if the number of detected blobs of a sync frame is different from the data width,
+        // or if the symbol clock of a Rolling Shutter LED is not recovered
+        if(error != KEV_SUCCESS || blobs.size() != getNumSyncBlobs() ||
+           (m_nDecodeType == KEV_VLC_DEC_RS && m_rRSEngine.isClockLocked() == false))
         {
             emit sig_printDebugMessage(QString("ROI Detection Error...Retry!"));
             m_nVLCState = KEV_VLC_STATE_IDLE;
             return false;
         }
 
-        // obtain a background image
-        m_rBgrdFrame /= KEV_VLC_NUM_SYNC_FRAMES;
-        m_rMeanROIs.clear();
+        // order the ROI blocks so that the channel order (and the clock index) is stable
+        sortBlobs(blobs);
 
         // build a list of ROI blocks using blobs
         rROIBlocks.clear();        
 
         for(VLCBlob &blob : blobs)
         {
-            rROIBlocks.push_back(KevDemoROIBlock(blob.contour));
-
-            // calculate means of ROI images
-            cv::Mat roiImage = cv::Mat(m_rBgrdFrame, blob.boundingRect);
-            m_rMeanROIs.push_back(cv::mean(roiImage).val[0]);
+            rROIBlocks.push_back(KevDemoROIBlock(*blob.contour));
         }
 
+        // calculate means of ROI images over the sync frames
+        measureMeanROIs(rROIBlocks);
+        m_nNumSyncFramesLeft = 0;
+
+        // build row spans of the ROI blocks for sampling data frames
+        m_rROISampler.configure(rROIBlocks);
+        m_rROITracker.configure(rROIBlocks.size());
+        trainLevels(rSyncFrame);
+
+        // keep the layout for re-locking the next transmission
+        m_rLastROIs = rROIBlocks;
+
 #ifdef KEV_VLC_DEC_DEBUG_ENABLE
         cv::imshow("detectROIs", roiFrame);
 #endif
@@ -476,6 +985,178 @@ KevDemoVLCDecoder::detectROIs(cv::Mat rSyncFrame, std::vector<KevDemoROIBlock> &
     return false;
 }
 
+/**
+ * @brief This function checks whether the blobs of a sync start frame match the ROI
+ *        layout of the last lock. The layout may be offset as a whole within a small
+ *        window, but each blob has to be close to its offset ROI.
+ * @param rBlobs blobs of a sync start frame, which are sorted in reading order
+ * @param rFrameSize frame size
+ * @return true if the last ROI layout matches the blobs, otherwise false
+ */
+bool
+KevDemoVLCDecoder::matchLastROIs(std::vector<VLCBlob>& rBlobs, cv::Size rFrameSize)
+{
+    // the symbol clock of a Rolling Shutter LED is recovered during the sync frames
+    if(m_nDecodeType != KEV_VLC_DEC_MI || m_rLastROIs.empty() == true ||
+       rBlobs.size() != m_rLastROIs.size())
+    {
+        return false;
+    }
+
+    sortBlobs(rBlobs);
+
+    // offset of the layout as the mean offset of the blobs from their ROIs
+    cv::Point offset(0, 0);
+
+    for(uint32_t i = 0; i < rBlobs.size(); i++)
+    {
+        cv::Rect rect = m_rLastROIs[i].getBoundingRect();
+
+        offset.x += rBlobs[i].centerPosition.x - (rect.x + rect.x + rect.width) / 2;
+        offset.y += rBlobs[i].centerPosition.y - (rect.y + rect.y + rect.height) / 2;
+    }
+
+    offset.x /= (int)rBlobs.size();
+    offset.y /= (int)rBlobs.size();
+
+    if(std::abs(offset.x) > KEV_VLC_RELOCK_RADIUS || std::abs(offset.y) > KEV_VLC_RELOCK_RADIUS)
+    {
+        return false;
+    }
+
+    cv::Rect frameRect(0, 0, rFrameSize.width, rFrameSize.height);
+
+    for(uint32_t i = 0; i < rBlobs.size(); i++)
+    {
+        cv::Rect rect = m_rLastROIs[i].getBoundingRect();
+
+        int dx = rBlobs[i].centerPosition.x - ((rect.x + rect.x + rect.width) / 2 + offset.x);
+        int dy = rBlobs[i].centerPosition.y - ((rect.y + rect.y + rect.height) / 2 + offset.y);
+
+        if(std::abs(dx) > KEV_VLC_RELOCK_TOLERANCE || std::abs(dy) > KEV_VLC_RELOCK_TOLERANCE)
+        {
+            return false;
+        }
+
+        // the offset ROI has to stay inside the frame
+        rect.x += offset.x;
+        rect.y += offset.y;
+
+        if((rect & frameRect) != rect)
+        {
+            return false;
+        }
+    }
+
+    m_rRelockOffset = offset;
+
+    return true;
+}
+
+/**
+ * @brief This function restores the ROI blocks of the last lock, moved by the offset
+ *        found by matchLastROIs(), and measures their background means at the moved
+ *        ROIs over the verified sync frames. The sync frames still to be sent by the
+ *        transmitter are skipped by the first data frames.
+ * @param rROIBlocks re-locked ROI blocks
+ */
+void
+KevDemoVLCDecoder::relockROIs(std::vector<KevDemoROIBlock>& rROIBlocks)
+{
+    // the blocks are assigned over the last ones to reuse the buffers of their contours
+    rROIBlocks = m_rLastROIs;
+
+    for(KevDemoROIBlock &block : rROIBlocks)
+    {
+        block.translate(m_rRelockOffset);
+    }
+
+    measureMeanROIs(rROIBlocks);
+
+    // build row spans of the ROI blocks for sampling data frames
+    m_rROISampler.configure(rROIBlocks);
+    m_rROITracker.configure(rROIBlocks.size());
+
+    // follow the layout if it moves slowly over transmissions
+    m_rLastROIs = rROIBlocks;
+
+    m_nNumSyncFramesLeft = (getNumSyncFrames() > m_nFrameCounter) ? getNumSyncFrames() - m_nFrameCounter : 0;
+    m_rSyncStates.clear();
+
+    emit sig_printDebugMessage(QString("ROI Re-locked."));
+}
+
+/**
+ * @brief This function measures the background means of the ROI blocks from the sum
+ *        of the sync frames received so far, without the slots of the missed ones.
+ * @param rROIBlocks ROI blocks
+ */
+void
+KevDemoVLCDecoder::measureMeanROIs(std::vector<KevDemoROIBlock>& rROIBlocks)
+{
+    uint32_t numFrames = std::max<uint32_t>(m_nNumBgrdFrames, 1);
+
+    m_rMeanROIs.clear();
+
+    for(KevDemoROIBlock &block : rROIBlocks)
+    {
+        cv::Mat roiImage = cv::Mat(m_rBgrdFrame, block.getBoundingRect());
+        m_rMeanROIs.push_back(cv::mean(roiImage).val[0] / numFrames);
+    }
+}
+
+/**
+ * @brief This function checks whether a frame after a re-lock is one of the sync frames
+ *        left, in which all the LEDs are toggled from the previous frame.
+ * @param rFrame a frame after a re-lock
+ * @return true if the frame is a sync frame, otherwise false
+ */
+bool
+KevDemoVLCDecoder::isSyncFrameLeft(cv::Mat rFrame)
+{
+    if(m_rROISampler.sample(rFrame, m_rCurrMeanROIs) != KEV_SUCCESS)
+    {
+        return false;
+    }
+
+    bool isToggled = (m_rSyncStates.size() == m_rCurrMeanROIs.size());
+
+    m_rSyncStates.resize(m_rCurrMeanROIs.size());
+
+    for(uint32_t i = 0; i < m_rCurrMeanROIs.size(); i++)
+    {
+        int state = (m_rCurrMeanROIs[i] > m_rLevelTracker.getThreshold(i)) ? 1 : 0;
+
+        if(state == m_rSyncStates[i])
+        {
+            isToggled = false;
+        }
+
+        m_rSyncStates[i] = state;
+    }
+
+    return isToggled;
+}
+
+/**
+ * @brief This function initializes the on & off levels of the ROI blocks with the given
+ *        and the previous sync frames, in which all the LEDs are toggled. The background
+ *        means are the mid levels of LEDs without enough contrast in these frames.
+ * @param rSyncFrame the last sync frame
+ */
+void
+KevDemoVLCDecoder::trainLevels(cv::Mat rSyncFrame)
+{
+    if(m_rROISampler.sample(m_rPrevFrame, m_rPrevMeanROIs) != KEV_SUCCESS ||
+       m_rROISampler.sample(rSyncFrame, m_rCurrMeanROIs) != KEV_SUCCESS)
+    {
+        m_rLevelTracker.train(m_rMeanROIs, m_rMeanROIs, m_rMeanROIs);
+        return;
+    }
+
+    m_rLevelTracker.train(m_rMeanROIs, m_rPrevMeanROIs, m_rCurrMeanROIs);
+}
+
 /**
  * @brief This function decodes a data frame using detected ROIs and returns decoded bits.
  * @param rDataFrame input data frame
@@ -487,6 +1168,8 @@ KevDemoVLCDecoder::decodeDataFrame(cv::Mat rDataFrame, std::vector<int> &rDecode
 {
     KevDemoError_t error;
 
+    m_rDecodedSoftValues.clear();
+
     if(m_nDecodeType == KEV_VLC_DEC_MI)
     {
         error = decodeDataMIFrame(rDataFrame, rDecodedSignals);
@@ -500,6 +1183,24 @@ KevDemoVLCDecoder::decodeDataFrame(cv::Mat rDataFrame, std::vector<int> &rDecode
         error = KEV_ERROR_UNKNOWN_VLC_DECODER;
     }
 
+    // signals decided without a level are fully confident
+    if(m_rDecodedSoftValues.size() != rDecodedSignals.size())
+    {
+        m_rDecodedSoftValues.clear();
+
+        for(int signal : rDecodedSignals)
+        {
+            m_rDecodedSoftValues.push_back(signal ? 1.0f : -1.0f);
+        }
+    }
+
+    m_rDecodedConfidences.clear();
+
+    for(float softValue : m_rDecodedSoftValues)
+    {
+        m_rDecodedConfidences.push_back((uint8_t)(std::abs(softValue) * KEV_BIT_STREAM_MAX_CONFIDENCE));
+    }
+
     return error;
 }
 
@@ -512,76 +1213,37 @@ KevDemoVLCDecoder::decodeDataFrame(cv::Mat rDataFrame, std::vector<int> &rDecode
 KevDemoError_t
 KevDemoVLCDecoder::decodeDataMIFrame(cv::Mat rDataFrame, std::vector<int> &rDecodedSignals)
 {
-    int i = 0;
     rDecodedSignals.clear();
 
-    for(KevDemoROIBlock &roiBlock : m_rDetectedROIs)
-    {
-        // a rectangle region of ROI
-        cv::Rect roiRect = roiBlock.getBoundingRect();
-
-        // extracted previous and current ROI images
-        cv::Mat prevRoiImage = cv::Mat(m_rPrevFrame, roiRect);
-        cv::Mat currRoiImage = cv::Mat(  rDataFrame, roiRect);
-
-#if 1
-        // obtain the decoded signal using the mean value of an ROI image
-        float meanROI = cv::mean(currRoiImage).val[0];
-
-        if(meanROI >= m_rMeanROIs[i])
-        {
-            rDecodedSignals.push_back(1);
-        }
-        else
-        {
-            rDecodedSignals.push_back(0);
-        }
-#else
-        // obtain the difference of the previous and current ROI images
-        cv::Mat subRoiImage1;
-        cv::Mat subRoiImage2;
+    // obtain the mean values of all ROI images in a single pass
+    KevDemoError_t error = m_rROISampler.sample(rDataFrame, m_rCurrMeanROIs);
 
-        subtractFrame(prevRoiImage, currRoiImage, subRoiImage1);
-        subtractFrame(currRoiImage, prevRoiImage, subRoiImage2);
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
 
-        // calculate the mean of ROI substraction images
-        float meanPTC = cv::mean(subRoiImage1).val[0];
-        float meanCTP = cv::mean(subRoiImage2).val[0];
+    // obtain the decoded signals against the running on & off levels of ROI blocks,
+    // which follow ambient light changes over the data frames
+    m_rLevelTracker.decide(m_rCurrMeanROIs, rDecodedSignals, m_rDecodedSoftValues);
 
-        if(meanPTC < m_nThreshold) meanPTC = 0;
-        if(meanCTP < m_nThreshold) meanCTP = 0;
+    // obtain the transitions of LEDs from the ROI sums of the previous and current frames
+    if(m_bIsManchester == true)
+    {
+        m_rManchester.update(m_rROISampler.getSums(), m_rROISampler.getAreas(), m_rLevelTracker);
+    }
 
-        // determine VLC signals for this frame
-        if(meanPTC > meanCTP)
-        {
-            rDecodedSignals.push_back(KEV_VLC_MANCH_FALLING);
-        }
-        else if(meanPTC < meanCTP)
-        {
-            rDecodedSignals.push_back(KEV_VLC_MANCH_RISING);
-        }
-        else
-        {
-            rDecodedSignals.push_back(KEV_VLC_MANCH_HOLDING);
-        }
-#endif
+    // follow the LEDs drifting from their ROI blocks, e.g. while a vehicle settles
+    if(m_bIsTracking == true &&
+       m_rROITracker.track(rDataFrame, m_rDetectedROIs, m_rDecodedSoftValues, m_rLevelTracker) == true)
+    {
+        m_rROISampler.configure(m_rDetectedROIs);
+        m_rLastROIs = m_rDetectedROIs;
+    }
 
-#ifdef KEV_VLC_DEC_DEBUG_ENABLE
-        QString imgNumber1("ROI image1: ");
-        imgNumber1 += QString::number(m_nFrameCounter);
-        QString imgNumber2("ROI image2: ");
-        imgNumber2 += QString::number(m_nFrameCounter);
-        QString imgNumber3("ROI image3: ");
-        imgNumber3 += QString::number(m_nFrameCounter);
-
-        cv::imshow(imgNumber1.toStdString(), currRoiImage);
-        cv::imshow(imgNumber2.toStdString(), subRoiImage1);
-        cv::imshow(imgNumber3.toStdString(), subRoiImage2);
-
-        QString str = QString("> P-C: ") + QString::number(meanPTC) +
-                      QString(", C-P: ") + QString::number(meanCTP);
-        emit sig_printDebugMessage(str);
-#endif
+    if(m_bIsManchester == true)
+    {
+        m_rManchester.classify(rDecodedSignals, m_rDecodedSoftValues);
     }
 
     return KEV_SUCCESS;
@@ -598,7 +1260,33 @@ KevDemoVLCDecoder::decodeDataRSFrame(cv::Mat rDataFrame, std::vector<int> &rDeco
 {
     KevDemoError_t error = KEV_SUCCESS;
 
-    // Rolling Shutter Algorithm
+    rDecodedSignals.clear();
+
+    if(m_rDetectedROIs.empty() == true)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    // obtain the per-row intensity profile of the LED region
+    cv::Rect region = m_rDetectedROIs[0].getBoundingRect();
+
+    if((error = m_rRSEngine.extractProfile(rDataFrame, region)) != KEV_SUCCESS)
+    {
+        return error;
+    }
+
+    // detect the bands, keep tracking the symbol clock and extract packets
+    m_rRSEngine.detectEdges();
+    m_rRSEngine.trainClock(m_nDataWidth);
+
+    if(m_rRSEngine.decodePackets(m_nDataWidth, rDecodedSignals) == 0)
+    {
+        m_nNumConsEmptyFrames++;
+    }
+    else
+    {
+        m_nNumConsEmptyFrames = 0;
+    }
 
     return error;
 }
@@ -607,16 +1295,48 @@ KevDemoVLCDecoder::decodeDataRSFrame(cv::Mat rDataFrame, std::vector<int> &rDeco
  * @brief This function draws blobs on the given frame.
  * @param rFrame an image frame
  * @param rBlobs blobs to be drawn on the image frame
+ * @param rColor a color of the blobs
  */
 void
-KevDemoVLCDecoder::drawBlobsToFrame(cv::Mat &rFrame, std::vector<VLCBlob> rBlobs)
+KevDemoVLCDecoder::drawBlobsToFrame(cv::Mat &rFrame, const std::vector<VLCBlob>& rBlobs, const cv::Scalar& rColor)
 {
-    // build a list of convexhulls
-    std::vector<std::vector<cv::Point> > convexHulls;
+    // the contours are convex hulls, which are filled without building a list of them
+    for(const VLCBlob &blob : rBlobs)
+    {
+        cv::fillConvexPoly(rFrame, blob.contour->data(), (int)blob.contour->size(), rColor);
+    }
+}
+
+/**
+ * @brief This function adds a vote to the sync votes for each pixel of the blobs of a
+ *        sync frame. The blobs are drawn into a mask only over their bounding box, from
+ *        which the votes are added with saturation. A blob is drawn with a single vote,
+ *        so that the sync votes count the sync frames in which a pixel belongs to a blob.
+ * @param rBlobs blobs of a sync frame
+ */
+void
+KevDemoVLCDecoder::voteBlobs(std::vector<VLCBlob>& rBlobs)
+{
+    cv::Rect region;
 
-    for (VLCBlob &blob : rBlobs) {
-        convexHulls.push_back(blob.contour);
+    for(VLCBlob &blob : rBlobs)
+    {
+        region = (region.area() <= 0) ? blob.boundingRect : (region | blob.boundingRect);
     }
 
-    cv::drawContours(rFrame, convexHulls, -1, COLOR_BLOBS, -1);
+    region &= cv::Rect(0, 0, m_rSyncFrame.cols, m_rSyncFrame.rows);
+
+    if(region.area() <= 0)
+    {
+        return;
+    }
+
+    cv::Mat &blobMask = m_rFrameArena.getScratch(KEV_VLC_SCRATCH_BLOB, m_rSyncFrame.size(), CV_8UC1);
+    cv::Mat maskRegion = blobMask(region);
+    cv::Mat voteRegion = m_rSyncFrame(region);
+
+    maskRegion.setTo(COLOR_BLACK);
+    drawBlobsToFrame(blobMask, rBlobs, COLOR_VOTE);
+
+    cv::add(voteRegion, maskRegion, voteRegion, cv::noArray(), CV_16U);
 }
@@ -3,6 +3,22 @@
 
 #include "KevDemoConfig.h"
 #include "KevDemoROIBlock.h"
+#include "KevDemoDiffKernel.h"
+#include "KevDemoROISampler.h"
+#include "KevDemoROITracker.h"
+#include "KevDemoFrameArena.h"
+#include "KevDemoRSEngine.h"
+#include "KevDemoBlobLabeler.h"
+#include "KevDemoMorphology.h"
+#include "KevDemoActivityDetector.h"
+#include "KevDemoLevelTracker.h"
+#include "KevDemoSymbolClock.h"
+#include "KevDemoSymbolTimer.h"
+#include "KevDemoFrameSource.h"
+#include "KevDemoBitStream.h"
+#include "KevDemoVLCFramer.h"
+#include "KevDemoSoftVoter.h"
+#include "KevDemoManchesterDecoder.h"
 
 // VLC decoders
 #define KEV_VLC_DEC_MI  0
@@ -15,15 +31,43 @@
 
 // VLC default number of frames
 #define KEV_VLC_NUM_IDLE_FRAMES  10
-#define KEV_VLC_NUM_SYNC_FRAMES  20
+#define KEV_VLC_NUM_SYNC_FRAMES  8
 #define KEV_VLC_NUM_DATA_FRAMES  60
 
+// VLC number of sync frames for Rolling Shutter decoder
+#define KEV_VLC_NUM_RS_SYNC_FRAMES  4
+
+// VLC re-lock of the last ROI layout: the maximum offset of the layout, and
+// the maximum distance of each sync start blob from its offset ROI (pixels)
+#define KEV_VLC_RELOCK_RADIUS       16
+#define KEV_VLC_RELOCK_TOLERANCE    4
+
+// VLC number of sync frames verifying a re-locked layout, which is even so that the
+// background means are taken over as many on as off frames
+#define KEV_VLC_RELOCK_FRAMES       2
+
+// VLC filter size to merge the bands of a Rolling Shutter LED
+#define KEV_VLC_RS_FILTER_SIZE      9
+
 // VLC default threshold
 #define KEV_VLC_DEFAULT_THRESHOLD   128
 
-#define KEV_VLC_MANCH_HOLDING     0
-#define KEV_VLC_MANCH_FALLING     1
-#define KEV_VLC_MANCH_RISING      2
+// VLC frame ring size
+#define KEV_VLC_FRAME_RING_SIZE   2
+
+// VLC data region: the margin around the ROI blocks, within which they may move before
+// a crop follows them (pixels), and the number of the last data frames of a burst
+// captured as a whole again, so that the next sync frames are not cropped
+#define KEV_VLC_CROP_MARGIN         16
+#define KEV_VLC_CROP_LEAD_FRAMES    8
+
+// VLC scratch buffers
+#define KEV_VLC_SCRATCH_DIFF      0
+#define KEV_VLC_SCRATCH_SYNC      1
+#define KEV_VLC_SCRATCH_BGRD      2
+#define KEV_VLC_SCRATCH_BLOB      3
+#define KEV_VLC_SCRATCH_ROI       4
+#define KEV_VLC_NUM_SCRATCHES     5
 
 /**
  * @brief a class for VLC decoding
@@ -34,7 +78,7 @@ class KevDemoVLCDecoder : public QObject
 
 private:
 
-    const cv::Scalar COLOR_BLOBS = cv::Scalar( 10,  10,  10);
+    const cv::Scalar COLOR_VOTE  = cv::Scalar(  1,   1,   1);
     const cv::Scalar COLOR_BLACK = cv::Scalar(  0,   0,   0);
     const cv::Scalar COLOR_WHITE = cv::Scalar(255, 255, 255);
 
@@ -46,34 +90,126 @@ private:
     // decoder data width
     uint32_t m_nDataWidth;
 
-    // previous frame
+    // frame ring & scratch buffers
+    KevDemoFrameArena m_rFrameArena;
+
+    // previous frame (a frame of the ring), and whether only its ROI blocks are retained
     cv::Mat m_rPrevFrame;
-    // sync frame
+    bool m_bIsPrevCropped;
+    // votes of the blobs over the sync frames (CV_16UC1), saturating
     cv::Mat m_rSyncFrame;
-    // background frame
+    // sum of the sync frames for their background (CV_16UC1), saturating, and the number
+    // of the sync frames received into it
     cv::Mat m_rBgrdFrame;
+    uint32_t m_nNumBgrdFrames;
+
+    // fused blur/absdiff/threshold kernel
+    KevDemoDiffKernel m_rDiffKernel;
 
     // VLC state
     uint32_t m_nVLCState;
 
-    // means for ROI blocks
+    // background means for ROI blocks over the sync frames
     std::vector<float> m_rMeanROIs;
 
+    // means for ROI blocks of the current and previous frames
+    std::vector<float> m_rCurrMeanROIs;
+    std::vector<float> m_rPrevMeanROIs;
+
+    // adaptive on & off levels of ROI blocks
+    KevDemoLevelTracker m_rLevelTracker;
+
+    // decoded signals of the current data frame, and their soft values and confidences
+    std::vector<int> m_rDecodedSignals;
+    std::vector<float> m_rDecodedSoftValues;
+    std::vector<uint8_t> m_rDecodedConfidences;
+
+    // whether a symbol is decided once over its frames, and whether a symbol is voted
+    bool m_bIsSoftDecision;
+    bool m_bIsVoting;
+
+    // soft votes of the frames of a symbol, and the decided signals and confidences
+    KevDemoSoftVoter m_rSoftVoter;
+    std::vector<int> m_rVotedSignals;
+    std::vector<uint8_t> m_rVotedConfidences;
+
+    // decoded bits of decode() into a list of bits
+    KevDemoBitStream m_rBitStream;
+
     // detected ROI blocks for VLC
     std::vector<KevDemoROIBlock> m_rDetectedROIs;
 
+    // ROI blocks of the last lock
+    std::vector<KevDemoROIBlock> m_rLastROIs;
+
+    // whether the last ROI layout matches the current sync start frame, and its offset
+    bool m_bIsRelocked;
+    cv::Point m_rRelockOffset;
+
+    // number of the sync frames which may follow a re-lock, and the LED states of the last one
+    uint32_t m_nNumSyncFramesLeft;
+    std::vector<int> m_rSyncStates;
+
+    // single-pass sampler of the detected ROI blocks
+    KevDemoROISampler m_rROISampler;
+
+    // whether the ROI blocks follow the moving LEDs during the data frames
+    bool m_bIsTracking;
+    KevDemoROITracker m_rROITracker;
+
     // number of consecutive invalid frames
     uint32_t m_nNumConsEmptyFrames;
 
-    // frame counter
+    // frame counter, which counts the slots of the missed frames as well
     uint32_t m_nFrameCounter;
 
+    // frame and symbol schedule on frame timestamps, and the slots missed before the current frame
+    KevDemoSymbolTimer m_rSymbolTimer;
+    uint32_t m_nNumMissedFrames;
+
+    // bits of the symbols decided by the current frame in the clock LED modes
+    KevDemoBitStream m_rSymbolStream;
+
     // VLC clock index
-    int m_nClockIndex;
+    uint32_t m_nClockIndex;
 
     // previous decoded bits
     int m_rPrevClock;
 
+    // whether all the LEDs carry data without a clock LED
+    bool m_bIsClockless;
+
+    // symbol timing recovered from the data LEDs in clockless mode
+    KevDemoSymbolClock m_rSymbolClock;
+
+    // whether the data LEDs are Manchester-coded against the clock LED
+    bool m_bIsManchester;
+    KevDemoManchesterDecoder m_rManchester;
+
+    // whether the bits of a frame are a frame of KevDemoVLCFramer
+    bool m_bIsFramed;
+
+    // framer, and the collected bits and the decoded payload of a frame in framed mode
+    KevDemoVLCFramer m_rFramer;
+    KevDemoBitStream m_rFrameBits;
+    KevDemoBitStream m_rFramePayload;
+
+    // Rolling Shutter decoding engine
+    KevDemoRSEngine m_rRSEngine;
+
+    // morphological filter of blob masks
+    KevDemoMorphology m_rMorphology;
+
+    // coarse change detector of IDLE frames
+    KevDemoActivityDetector m_rActivityDetector;
+
+    // connected-component labeler of blob masks
+    KevDemoBlobLabeler m_rBlobLabeler;
+
+    // selected components and their convex hulls of the last labeled mask
+    std::vector<uint32_t> m_rSelectedBlobs;
+    std::vector<std::vector<cv::Point> > m_rBlobHulls;
+
     /**
      * @brief an internal class for presenting Blobs
      */
@@ -86,15 +222,16 @@ private:
         cv::Rect boundingRect;
         cv::Point centerPosition;
 
-        std::vector<cv::Point> contour;
+        // convex hull of the blob labeler, valid until the next blobs are detected
+        const std::vector<cv::Point> *contour;
 
         /**
          * @brief a constructor of VLC blob
-         * @param a contour used to build a VLC blob
+         * @param a contour used to build a VLC blob, which is referred to without a copy
          */
-        VLCBlob(std::vector<cv::Point> rContour)
+        VLCBlob(const std::vector<cv::Point>& rContour)
         {
-            contour = rContour;
+            contour = &rContour;
             boundingRect = cv::boundingRect(rContour);
 
             centerPosition.x = (boundingRect.x + boundingRect.x + boundingRect.width) / 2;
@@ -106,18 +243,46 @@ private:
 
         /**
          * @brief This function is used to validate the ROI block.
+         * @param nDecodeType decoder type
          * @return true if the block is a valid ROI, otherwise false
          */
-        inline bool isValid()
+        inline bool isValid(int nDecodeType = KEV_VLC_DEC_MI)
+        {
+            return isValidRect(boundingRect, nDecodeType);
+        }
+
+        /**
+         * @brief This function validates a bounding rectangle of a blob, so that
+         *        a blob can be rejected before its contour is built.
+         * @param rRect a bounding rectangle
+         * @param nDecodeType decoder type
+         * @return true if the rectangle bounds a valid ROI, otherwise false
+         */
+        static inline bool isValidRect(const cv::Rect& rRect, int nDecodeType = KEV_VLC_DEC_MI)
         {
-            if(boundingRect.area() < 60 || boundingRect.area() > 2000)  return false;
+            // a Rolling Shutter LED is a single large region tall enough to show bands
+            if(nDecodeType == KEV_VLC_DEC_RS)
+            {
+                if(rRect.area() < 400)                                  return false;
+                if(rRect.width < 16 || rRect.height < 32)               return false;
+                return true;
+            }
+
+            double aspectRatio = (float)rRect.width / (float)rRect.height;
+            double diagonalSize = sqrt(pow(rRect.width, 2) + pow(rRect.height, 2));
+
+            if(rRect.area() < 60 || rRect.area() > 2000)                return false;
             if(aspectRatio < 0.2 || aspectRatio > 1.25)                 return false;
-            if(boundingRect.width < 15 || boundingRect.height < 15)     return false;
+            if(rRect.width < 15 || rRect.height < 15)                   return false;
             if(diagonalSize < 20)                                       return false;
             return true;
         }
     };
 
+    // blobs of a sync frame, and the candidate blobs of a Rolling Shutter sync frame
+    std::vector<VLCBlob> m_rBlobs;
+    std::vector<VLCBlob> m_rCandidateBlobs;
+
 signals:
 
     void sig_performAuthentication(int nAuthInfo);
@@ -131,6 +296,9 @@ public:
 
     // VLC decoding procedures
     KevDemoError_t decode(cv::Mat& rCurrFrame, std::vector<int>& rDecodedOutput);
+    KevDemoError_t decode(cv::Mat& rCurrFrame, KevDemoBitStream& rBitStream);
+    KevDemoError_t decode(KevDemoFrame_t& rCurrFrame, std::vector<int>& rDecodedOutput);
+    KevDemoError_t decode(KevDemoFrame_t& rCurrFrame, KevDemoBitStream& rBitStream);
 
     // accessor & mutator
     inline void setThreshold(uint32_t nThreshold)   { m_nThreshold = nThreshold; }
@@ -142,6 +310,38 @@ public:
     inline void setClockIndex(uint32_t nClockIndex) { m_nClockIndex = nClockIndex; }
     inline uint32_t getClockIndex()                 { return m_nClockIndex;        }
 
+    inline void setClockless(bool bIsClockless)     { m_bIsClockless = bIsClockless; }
+    inline bool isClockless()                       { return m_bIsClockless;         }
+
+    inline void setManchester(bool bIsManchester)       { m_bIsManchester = bIsManchester;     }
+    inline bool isManchester()                          { return m_bIsManchester;              }
+
+    inline void setTracking(bool bIsTracking)           { m_bIsTracking = bIsTracking;         }
+    inline bool isTracking()                            { return m_bIsTracking;                }
+
+    inline void setSoftDecision(bool bIsSoftDecision)   { m_bIsSoftDecision = bIsSoftDecision; }
+    inline bool isSoftDecision()                        { return m_bIsSoftDecision;            }
+
+    inline void setFramed(bool bIsFramed)           { m_bIsFramed = bIsFramed; m_rFrameBits.clear(); }
+    inline bool isFramed()                          { return m_bIsFramed;            }
+
+    inline const KevDemoFramerStats_t& getFramerStats() { return m_rFramer.getStats(); }
+
+    inline uint32_t getDecodeType()                 { return m_nDecodeType; }
+    inline uint32_t getState()                      { return m_nVLCState;   }
+
+    inline void setIdleScale(uint32_t nScale)       { m_rActivityDetector.setScale(nScale); }
+    inline uint32_t getIdleScale()                  { return m_rActivityDetector.getScale(); }
+
+    inline uint64_t getNumReallocations()           { return m_rFrameArena.getNumReallocations(); }
+
+    // region of the next frames read by the data frames of a burst
+    cv::Rect getDataRegion();
+
+    inline void setFrameInterval(double nInterval)  { m_rSymbolTimer.setFrameInterval(nInterval);  }
+    inline uint64_t getNumMissedFrames()            { return m_rSymbolTimer.getNumMissedFrames();  }
+    inline uint64_t getNumErasedSymbols()           { return m_rSymbolTimer.getNumErasedSymbols(); }
+
 private:
 
     /**
@@ -153,15 +353,48 @@ private:
         return m_nNumConsEmptyFrames > KEV_VLC_NUM_IDLE_FRAMES;
     }
 
+    /**
+     * @brief This function returns the number of blobs expected in a sync frame.
+     * @return one blob per LED for MIMO decoder, or a single LED for Rolling Shutter decoder
+     */
+    inline uint32_t getNumSyncBlobs()
+    {
+        return (m_nDecodeType == KEV_VLC_DEC_RS) ? 1 : m_nDataWidth;
+    }
+
+    /**
+     * @brief This function returns the number of sync frames to detect ROIs.
+     * @return the number of sync frames
+     */
+    inline uint32_t getNumSyncFrames()
+    {
+        return (m_nDecodeType == KEV_VLC_DEC_RS) ? KEV_VLC_NUM_RS_SYNC_FRAMES : KEV_VLC_NUM_SYNC_FRAMES;
+    }
+
+    // decode a frame on its slot
+    KevDemoError_t decodeFrame(cv::Mat& rCurrFrame, cv::Rect rRegion, KevDemoBitStream& rBitStream);
+
+    // region of the pixels read around the ROI blocks
+    cv::Rect getROIRegion();
+
     // detect sync start frame
     bool detectSyncStart(cv::Mat rFrame);
 
     // detect ROIs
     bool detectROIs(cv::Mat rSyncFrame, std::vector<KevDemoROIBlock>& rROIBlocks);
 
+    // re-lock the last ROI layout
+    bool matchLastROIs(std::vector<VLCBlob>& rBlobs, cv::Size rFrameSize);
+    void relockROIs(std::vector<KevDemoROIBlock>& rROIBlocks);
+    void measureMeanROIs(std::vector<KevDemoROIBlock>& rROIBlocks);
+    bool isSyncFrameLeft(cv::Mat rFrame);
+
+    // initialize the on & off levels of ROI blocks
+    void trainLevels(cv::Mat rSyncFrame);
+
     // decode a sync frame
-    KevDemoError_t decodeSyncFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs);
-    KevDemoError_t decodeSyncMIFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs);
+    KevDemoError_t decodeSyncFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs, cv::Rect rRegion = cv::Rect());
+    KevDemoError_t decodeSyncMIFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs, cv::Rect rRegion = cv::Rect());
     KevDemoError_t decodeSyncRSFrame(cv::Mat rCurrFrame, std::vector<VLCBlob>& rBlobs);
 
     // decode a data frame using detected ROIs
@@ -169,14 +402,27 @@ private:
     KevDemoError_t decodeDataMIFrame(cv::Mat rDataFrame, std::vector<int>& rDecodedSignals);
     KevDemoError_t decodeDataRSFrame(cv::Mat rDataFrame, std::vector<int>& rDecodedSignals);
 
+    // end a data burst and its frame of the bit stream
+    void endBurst(KevDemoBitStream& rBitStream);
+    void closeFrame(KevDemoBitStream& rBitStream);
+
+    // decide and append the bits of a symbol voted by its frames
+    void emitVotes(KevDemoBitStream& rBitStream);
+
+    // append the bits of the decided symbols on their schedule
+    void appendSymbols(KevDemoBitStream& rBitStream);
+
     // internal procedures for decoding
-    KevDemoError_t subtractFrame(cv::Mat rPrevFrame, cv::Mat rCurrFrame, cv::Mat& rSubFrame);
-    KevDemoError_t obtainDiffFrame(cv::Mat rPrevFrame, cv::Mat rCurrFrame, cv::Mat& rDiffFrame);
+    KevDemoError_t obtainDiffFrame(const cv::Mat& rPrevFrame, const cv::Mat& rCurrFrame, cv::Mat& rDiffFrame);
     KevDemoError_t filterMorphology(cv::Mat& rFrame, int nFilterSize);
     KevDemoError_t detectBlobs(cv::Mat rFrame, std::vector<VLCBlob>& rBlobs);
+    void sortBlobs(std::vector<VLCBlob>& rBlobs);
 
     // draw a blob frame
-    void drawBlobsToFrame(cv::Mat &rFrame, std::vector<VLCBlob> rBlobs);
+    void drawBlobsToFrame(cv::Mat &rFrame, const std::vector<VLCBlob>& rBlobs, const cv::Scalar& rColor);
+
+    // add the votes of the blobs of a sync frame
+    void voteBlobs(std::vector<VLCBlob>& rBlobs);
 };
 
 #endif // _KEV_DEMO_VLC_DECODER_H_
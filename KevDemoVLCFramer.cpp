@@ -0,0 +1,244 @@
+#include "KevDemoVLCFramer.h"
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoVLCFramer class
+ */
+KevDemoVLCFramer::KevDemoVLCFramer()
+{
+    resetStats();
+}
+
+/**
+ * @brief This is a destructor of KevDemoVLCFramer class
+ */
+KevDemoVLCFramer::~KevDemoVLCFramer()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function encodes a payload into a frame.
+ * @param rPayload payload bytes (up to KEV_VLC_FRAME_MAX_PAYLOAD)
+ * @param rFrame the bits of the frame are appended
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCFramer::encode(const std::vector<uint8_t>& rPayload, KevDemoBitStream& rFrame)
+{
+    if(rPayload.size() > KEV_VLC_FRAME_MAX_PAYLOAD)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    // length header, payload, and CRC of both
+    m_rBytes.clear();
+    m_rBytes.push_back((uint8_t)rPayload.size());
+    m_rBytes.insert(m_rBytes.end(), rPayload.begin(), rPayload.end());
+
+    uint16_t crc = computeCRC(m_rBytes.data(), m_rBytes.size());
+
+    m_rBytes.push_back(crc >> 8);
+    m_rBytes.push_back(crc & 0xFF);
+
+    // the codewords of the length header lead the frame
+    rFrame.appendBits(encodeNibble(m_rBytes[0] >> 4), KEV_VLC_FRAME_CODEWORD_BITS);
+    rFrame.appendBits(encodeNibble(m_rBytes[0] & 0xF), KEV_VLC_FRAME_CODEWORD_BITS);
+
+    m_rCodewords.clear();
+
+    for(size_t i = 1; i < m_rBytes.size(); i++)
+    {
+        m_rCodewords.push_back(encodeNibble(m_rBytes[i] >> 4));
+        m_rCodewords.push_back(encodeNibble(m_rBytes[i] & 0xF));
+    }
+
+    // interleave the codewords of the body bit by bit
+    for(int j = KEV_VLC_FRAME_CODEWORD_BITS - 1; j >= 0; j--)
+    {
+        for(uint8_t codeword : m_rCodewords)
+        {
+            rFrame.append((codeword >> j) & 1);
+        }
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function decodes a frame, correcting a bit error per codeword.
+ * @param rFrame the bits of a frame from its first bit, possibly followed by padding
+ * @param rPayload the payload bytes of an accepted frame
+ * @return error information, KEV_ERROR_VLC_FRAME_TRUNCATED if the frame is shorter than
+ *         its length header, or KEV_ERROR_VLC_FRAME_CORRUPTED if its CRC does not match
+ */
+KevDemoError_t
+KevDemoVLCFramer::decode(const KevDemoBitStream& rFrame, KevDemoBitStream& rPayload)
+{
+    const uint32_t headerBits = 2 * KEV_VLC_FRAME_CODEWORD_BITS;
+
+    uint32_t numCorrected = 0;
+
+    rPayload.clear();
+    m_rStats.numFrames++;
+
+    if(rFrame.getNumBits() < headerBits)
+    {
+        m_rStats.numTruncated++;
+        return KEV_ERROR_VLC_FRAME_TRUNCATED;
+    }
+
+    uint8_t length = (decodeCodeword(rFrame.readBits(0, KEV_VLC_FRAME_CODEWORD_BITS), numCorrected) << 4) |
+                      decodeCodeword(rFrame.readBits(KEV_VLC_FRAME_CODEWORD_BITS, KEV_VLC_FRAME_CODEWORD_BITS), numCorrected);
+
+    if(rFrame.getNumBits() < getFrameBits(length))
+    {
+        m_rStats.numTruncated++;
+        return KEV_ERROR_VLC_FRAME_TRUNCATED;
+    }
+
+    // deinterleave the codewords of the body
+    uint32_t numCodewords = 2 * (length + KEV_VLC_FRAME_CRC_BITS / 8);
+
+    m_rCodewords.assign(numCodewords, 0);
+
+    for(uint32_t j = 0, offset = headerBits; j < KEV_VLC_FRAME_CODEWORD_BITS; j++)
+    {
+        for(uint32_t i = 0; i < numCodewords; i++, offset++)
+        {
+            m_rCodewords[i] = (m_rCodewords[i] << 1) | rFrame.getBit(offset);
+        }
+    }
+
+    m_rBytes.clear();
+    m_rBytes.push_back(length);
+
+    for(uint32_t i = 0; i < numCodewords; i += 2)
+    {
+        m_rBytes.push_back((decodeCodeword(m_rCodewords[i], numCorrected) << 4) |
+                            decodeCodeword(m_rCodewords[i + 1], numCorrected));
+    }
+
+    uint16_t crc = (m_rBytes[length + 1] << 8) | m_rBytes[length + 2];
+
+    if(computeCRC(m_rBytes.data(), length + 1) != crc)
+    {
+        m_rStats.numCorrupted++;
+        return KEV_ERROR_VLC_FRAME_CORRUPTED;
+    }
+
+    for(uint32_t i = 1; i <= length; i++)
+    {
+        rPayload.appendBits(m_rBytes[i], 8);
+    }
+
+    m_rStats.numAccepted++;
+    m_rStats.numCorrectedBits += numCorrected;
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function resets the statistics of the decoded frames.
+ */
+void
+KevDemoVLCFramer::resetStats()
+{
+    m_rStats.numFrames = 0;
+    m_rStats.numAccepted = 0;
+    m_rStats.numTruncated = 0;
+    m_rStats.numCorrupted = 0;
+    m_rStats.numCorrectedBits = 0;
+}
+
+/**
+ * @brief This function returns the number of bits of a frame.
+ * @param nNumPayloadBytes the number of payload bytes
+ * @return the number of bits
+ */
+uint32_t
+KevDemoVLCFramer::getFrameBits(uint32_t nNumPayloadBytes)
+{
+    uint32_t numBytes = 1 + nNumPayloadBytes + KEV_VLC_FRAME_CRC_BITS / 8;
+
+    return numBytes * 2 * KEV_VLC_FRAME_CODEWORD_BITS;
+}
+
+/**
+ * @brief This function computes the CRC-16/CCITT-FALSE of bytes.
+ * @param pBytes bytes
+ * @param nLength the number of bytes
+ * @return the CRC
+ */
+uint16_t
+KevDemoVLCFramer::computeCRC(const uint8_t *pBytes, size_t nLength)
+{
+    uint16_t crc = KEV_VLC_FRAME_CRC_INIT;
+
+    for(size_t i = 0; i < nLength; i++)
+    {
+        crc ^= (uint16_t)pBytes[i] << 8;
+
+        for(int j = 0; j < 8; j++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ KEV_VLC_FRAME_CRC_POLY : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief This function encodes a nibble into a Hamming(7,4) codeword, whose bits from
+ *        the most significant one are p1 p2 d1 p3 d2 d3 d4.
+ * @param nNibble a nibble (d1 is its most significant bit)
+ * @return the codeword
+ */
+uint8_t
+KevDemoVLCFramer::encodeNibble(uint8_t nNibble)
+{
+    int d1 = (nNibble >> 3) & 1;
+    int d2 = (nNibble >> 2) & 1;
+    int d3 = (nNibble >> 1) & 1;
+    int d4 = nNibble & 1;
+
+    int p1 = d1 ^ d2 ^ d4;
+    int p2 = d1 ^ d3 ^ d4;
+    int p3 = d2 ^ d3 ^ d4;
+
+    return (p1 << 6) | (p2 << 5) | (d1 << 4) | (p3 << 3) | (d2 << 2) | (d3 << 1) | d4;
+}
+
+/**
+ * @brief This function decodes a Hamming(7,4) codeword, correcting a bit error.
+ * @param nCodeword a codeword
+ * @param rNumCorrected incremented if a bit is corrected
+ * @return the nibble
+ */
+uint8_t
+KevDemoVLCFramer::decodeCodeword(uint8_t nCodeword, uint32_t& rNumCorrected)
+{
+    // bit of a position (1 to 7) of the codeword
+    auto bit = [&nCodeword](int nPosition) { return (nCodeword >> (KEV_VLC_FRAME_CODEWORD_BITS - nPosition)) & 1; };
+
+    int s1 = bit(1) ^ bit(3) ^ bit(5) ^ bit(7);
+    int s2 = bit(2) ^ bit(3) ^ bit(6) ^ bit(7);
+    int s3 = bit(4) ^ bit(5) ^ bit(6) ^ bit(7);
+
+    // the syndrome is the position of the erroneous bit
+    int position = s1 | (s2 << 1) | (s3 << 2);
+
+    if(position != 0)
+    {
+        nCodeword ^= 1 << (KEV_VLC_FRAME_CODEWORD_BITS - position);
+        rNumCorrected++;
+    }
+
+    return (bit(3) << 3) | (bit(5) << 2) | (bit(6) << 1) | bit(7);
+}
@@ -0,0 +1,82 @@
+#ifndef _KEV_DEMO_VLC_FRAMER_H_
+#define _KEV_DEMO_VLC_FRAMER_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoBitStream.h"
+
+// maximum number of payload bytes of a frame
+#define KEV_VLC_FRAME_MAX_PAYLOAD   255
+
+// Hamming(7,4) codewords of a frame
+#define KEV_VLC_FRAME_CODEWORD_BITS 7
+#define KEV_VLC_FRAME_NIBBLE_BITS   4
+
+// bits of the length header and of the CRC-16 before encoding
+#define KEV_VLC_FRAME_HEADER_BITS   8
+#define KEV_VLC_FRAME_CRC_BITS      16
+
+// CRC-16/CCITT-FALSE polynomial and initial value
+#define KEV_VLC_FRAME_CRC_POLY      0x1021
+#define KEV_VLC_FRAME_CRC_INIT      0xFFFF
+
+/**
+ * @brief statistics of the decoded frames
+ */
+typedef struct KevDemoFramerStats {
+    uint64_t numFrames;
+    uint64_t numAccepted;
+    uint64_t numTruncated;
+    uint64_t numCorrupted;
+
+    // bits corrected by the codewords of the accepted frames
+    uint64_t numCorrectedBits;
+} KevDemoFramerStats_t;
+
+/**
+ * @brief a class for framing VLC payloads with a length header, a CRC and FEC
+ *
+ * A frame is a length byte followed by the payload bytes and the CRC-16 of both.
+ * Every nibble is encoded into a Hamming(7,4) codeword, so that one bit error per
+ * codeword is corrected in place. The codewords of the length byte lead the frame,
+ * and the codewords of the body are interleaved bit by bit, so that the bits of a
+ * symbol, or of a LED over several symbols, fall into different codewords. The CRC
+ * rejects the frames with more errors than the codewords correct. Trailing bits
+ * after a frame, e.g. the padding of a burst, are ignored.
+ */
+class KevDemoVLCFramer
+{
+private:
+
+    // codeword buffer of the body
+    std::vector<uint8_t> m_rCodewords;
+
+    // decoded bytes of the length header and the body
+    std::vector<uint8_t> m_rBytes;
+
+    KevDemoFramerStats_t m_rStats;
+
+public:
+
+    explicit KevDemoVLCFramer();
+    virtual ~KevDemoVLCFramer();
+
+    // framing procedures
+    KevDemoError_t encode(const std::vector<uint8_t>& rPayload, KevDemoBitStream& rFrame);
+    KevDemoError_t decode(const KevDemoBitStream& rFrame, KevDemoBitStream& rPayload);
+
+    void resetStats();
+
+    // accessor
+    inline const KevDemoFramerStats_t& getStats()   { return m_rStats; }
+
+    static uint32_t getFrameBits(uint32_t nNumPayloadBytes);
+    static uint16_t computeCRC(const uint8_t *pBytes, size_t nLength);
+
+private:
+
+    // Hamming(7,4) codec of a nibble
+    static uint8_t encodeNibble(uint8_t nNibble);
+    static uint8_t decodeCodeword(uint8_t nCodeword, uint32_t& rNumCorrected);
+};
+
+#endif // _KEV_DEMO_VLC_FRAMER_H_
@@ -0,0 +1,345 @@
+#include "KevDemoVLCPipeline.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoVLCPipeline class
+ * @param pVLCDecoder a VLC decoder to be run by the decode stage
+ */
+KevDemoVLCPipeline::KevDemoVLCPipeline(KevDemoVLCDecoder *pVLCDecoder) :
+    m_rDecodeRing(KEV_VLC_DECODE_QUEUE_SIZE),
+    m_rDisplayQueue(KEV_VLC_DISPLAY_QUEUE_SIZE)
+{
+    m_pVLCDecoder = pVLCDecoder;
+    m_nThreshold = 0;
+    m_nDataWidth = 0;
+    m_nDecodeScale = KEV_VLC_DEFAULT_DECODE_SCALE;
+    m_bSettingsChanged = false;
+    m_bIsDecoding = false;
+    m_bIsRunning = false;
+}
+
+/**
+ * @brief This is a destructor of KevDemoVLCPipeline class
+ */
+KevDemoVLCPipeline::~KevDemoVLCPipeline()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function starts the decode stage.
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCPipeline::open()
+{
+    if(m_pVLCDecoder == nullptr)
+    {
+        return KEV_ERROR_VLC_NOT_OPENED;
+    }
+
+    m_rDecodeRing.clear();
+    m_rDisplayQueue.open();
+    m_rCaptureCrop = cv::Rect();
+
+    // Start the thread
+    m_bIsRunning = true;
+    this->start();
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function stops the decode stage and drops the queued frames.
+ */
+void
+KevDemoVLCPipeline::close()
+{
+    m_bIsRunning = false;
+
+    this->wait();
+
+    m_rDecodeRing.clear();
+    m_rDisplayQueue.clear();
+}
+
+/**
+ * @brief This function changes the threshold of the decoder from the next frame.
+ * @param nThreshold threshold
+ */
+void
+KevDemoVLCPipeline::setThreshold(uint32_t nThreshold)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_nThreshold = nThreshold;
+    m_bSettingsChanged = true;
+}
+
+/**
+ * @brief This function changes the data width of the decoder from the next frame.
+ * @param nDataWidth data width
+ */
+void
+KevDemoVLCPipeline::setDataWidth(uint32_t nDataWidth)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_nDataWidth = nDataWidth;
+    m_bSettingsChanged = true;
+}
+
+/**
+ * @brief This function sets the downscale factor of the decode stage. Frames are decoded
+ *        at the capture resolution divided by the factor, regardless of the display size.
+ * @param nDecodeScale downscale factor (1 for the capture resolution)
+ */
+void
+KevDemoVLCPipeline::setDecodeScale(uint32_t nDecodeScale)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_nDecodeScale = std::max<uint32_t>(nDecodeScale, 1);
+}
+
+/**
+ * @brief This function enables or disables decoding. Frames are still displayed
+ *        while decoding is disabled.
+ * @param bIsDecoding true to decode frames
+ */
+void
+KevDemoVLCPipeline::setDecodingEnabled(bool bIsDecoding)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    m_bIsDecoding = bIsDecoding;
+}
+
+/**
+ * @brief This function pops the latest decoded frame, dropping older ones.
+ * @param rFrame the latest frame
+ * @return true if a frame is popped, otherwise false
+ */
+bool
+KevDemoVLCPipeline::popDisplayFrame(cv::Mat& rFrame)
+{
+    bool isPopped = false;
+
+    while(m_rDisplayQueue.pop(rFrame) == true)
+    {
+        isPopped = true;
+    }
+
+    return isPopped;
+}
+
+/**
+ * @brief This function takes the batch of bits and frame ends decoded since the last call.
+ * @param rDecodedStream decoded bits
+ * @return true if any bit or frame end is decoded, otherwise false
+ */
+bool
+KevDemoVLCPipeline::takeDecodedBits(KevDemoBitStream& rDecodedStream)
+{
+    QMutexLocker locker(&m_rMutex);
+
+    rDecodedStream.clear();
+    rDecodedStream.swap(m_rDecodedStream);
+
+    return rDecodedStream.isEmpty() == false;
+}
+
+/**
+ * @brief This function returns the number of frames dropped by the pipeline queues.
+ * @return the number of dropped frames
+ */
+uint64_t
+KevDemoVLCPipeline::getNumDroppedFrames()
+{
+    return m_rDecodeRing.getNumDropped() + m_rDisplayQueue.getNumDropped();
+}
+
+/**
+ * @brief This function applies the settings changed by the GUI thread to the decoder.
+ * @return true if decoding is enabled, otherwise false
+ */
+bool
+KevDemoVLCPipeline::applySettings()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    if(m_bSettingsChanged == true)
+    {
+        if(m_nThreshold > 0) m_pVLCDecoder->setThreshold(m_nThreshold);
+        if(m_nDataWidth > 0) m_pVLCDecoder->setDataWidth(m_nDataWidth);
+
+        m_bSettingsChanged = false;
+    }
+
+    return m_bIsDecoding;
+}
+
+/**
+ * @brief This function runs the decode stage.
+ */
+void
+KevDemoVLCPipeline::run()
+{
+    while(m_bIsRunning == true)
+    {
+        if(m_rDecodeRing.pop(m_rCaptureFrame, KEV_VLC_PIPELINE_WAIT_MS) == false)
+        {
+            continue;
+        }
+
+        bool isDecoding = applySettings();
+
+        uint32_t decodeScale;
+        {
+            QMutexLocker locker(&m_rMutex);
+            decodeScale = m_nDecodeScale;
+        }
+
+        cv::Mat &captureFrame = m_rCaptureFrame.image;
+        cv::Rect decodeRegion = m_rCaptureFrame.region;
+
+        // decode the captured frame in place unless it is downscaled
+        if(decodeScale > 1)
+        {
+            cv::Size decodeSize(captureFrame.cols / decodeScale, captureFrame.rows / decodeScale);
+
+            if(decodeRegion.area() > 0)
+            {
+                // only the pixels of the decode frame inside the crop are downscaled
+                decodeRegion = cv::Rect((decodeRegion.x + decodeScale - 1) / decodeScale,
+                                        (decodeRegion.y + decodeScale - 1) / decodeScale, 0, 0);
+                decodeRegion.width = (m_rCaptureFrame.region.br().x / decodeScale) - decodeRegion.x;
+                decodeRegion.height = (m_rCaptureFrame.region.br().y / decodeScale) - decodeRegion.y;
+                decodeRegion &= cv::Rect(0, 0, decodeSize.width, decodeSize.height);
+
+                // a crop narrower than a decoded pixel holds none
+                if(decodeRegion.area() <= 0)
+                {
+                    continue;
+                }
+            }
+
+            if(decodeRegion.area() > 0)
+            {
+                cv::Rect captureRegion(decodeRegion.x * decodeScale, decodeRegion.y * decodeScale,
+                                       decodeRegion.width * decodeScale, decodeRegion.height * decodeScale);
+
+                if(m_rDecodeFrame.size() != decodeSize || m_rDecodeFrame.type() != captureFrame.type())
+                {
+                    m_rDecodeFrame.create(decodeSize, captureFrame.type());
+                    m_rDecodeFrame.setTo(cv::Scalar::all(0));
+                }
+
+                cv::Mat decodeView = m_rDecodeFrame(decodeRegion);
+                cv::resize(captureFrame(captureRegion), decodeView, decodeRegion.size(), 0, 0, cv::INTER_AREA);
+            }
+            else
+            {
+                cv::resize(captureFrame, m_rDecodeFrame, decodeSize, 0, 0, cv::INTER_AREA);
+            }
+        }
+
+        cv::Mat &decodeFrame = (decodeScale > 1) ? m_rDecodeFrame : captureFrame;
+
+        // perform VLC decoding
+        if(isDecoding == true)
+        {
+            m_rFrameStream.clear();
+
+            // the frame is decoded on the slot of its timestamp to keep the symbol timing
+            // over the missed frames
+            KevDemoFrame_t frame = m_rCaptureFrame;
+            frame.image = decodeFrame;
+            frame.region = decodeRegion;
+
+            if(m_pVLCDecoder->decode(frame, m_rFrameStream) == KEV_SUCCESS &&
+               m_rFrameStream.isEmpty() == false)
+            {
+                QMutexLocker locker(&m_rMutex);
+
+                bool isFirstBatch = m_rDecodedStream.isEmpty();
+                m_rDecodedStream.append(m_rFrameStream);
+
+                locker.unlock();
+
+                // notify the GUI thread once per batch
+                if(isFirstBatch == true)
+                {
+                    emit sig_bitsDecoded();
+                }
+            }
+        }
+
+        requestCrop(decodeScale, isDecoding);
+
+        // notify the GUI thread once until it pops the frames
+        if(m_rDisplayQueue.push(decodeFrame, decodeRegion) == 1)
+        {
+            emit sig_frameReady();
+        }
+    }
+}
+
+/**
+ * @brief This function requests a crop of the captured frames to the data region of
+ *        the decoder, or the whole frames outside the data frames of a burst. A crop
+ *        is requested only when it changes.
+ * @param nDecodeScale downscale factor of the decode stage
+ * @param bIsDecoding whether the decoder runs
+ */
+void
+KevDemoVLCPipeline::requestCrop(uint32_t nDecodeScale, bool bIsDecoding)
+{
+    cv::Rect crop;
+
+    if(bIsDecoding == true)
+    {
+        cv::Rect region = m_pVLCDecoder->getDataRegion();
+        cv::Size captureSize = m_rCaptureFrame.image.size();
+
+        crop = cv::Rect(region.x * nDecodeScale, region.y * nDecodeScale,
+                        region.width * nDecodeScale, region.height * nDecodeScale);
+        crop &= cv::Rect(0, 0, captureSize.width, captureSize.height);
+    }
+
+    if(crop == m_rCaptureCrop)
+    {
+        return;
+    }
+
+    m_rCaptureCrop = crop;
+
+    emit sig_requestCrop(QRect(crop.x, crop.y, crop.width, crop.height));
+}
+
+//////////////////////////////////////////////////
+// Slot Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a slot function to push a captured frame into the decode ring. It is
+ *        called only on the capture thread, and returns without waiting for decoding.
+ * @param rFrame a captured frame
+ */
+void
+KevDemoVLCPipeline::slot_pushFrame(KevDemoFrame_t rFrame)
+{
+    if(m_bIsRunning == true && rFrame.image.empty() == false)
+    {
+        m_rDecodeRing.push(rFrame);
+    }
+}
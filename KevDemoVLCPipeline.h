@@ -0,0 +1,129 @@
+#ifndef _KEV_DEMO_VLC_PIPELINE_H_
+#define _KEV_DEMO_VLC_PIPELINE_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoVLCDecoder.h"
+#include "KevDemoFrameQueue.h"
+#include "KevDemoFrameRing.h"
+
+#include <atomic>
+#include <QMutex>
+#include <QRect>
+
+// capacities of the pipeline queues
+#define KEV_VLC_DECODE_QUEUE_SIZE   4
+#define KEV_VLC_DISPLAY_QUEUE_SIZE  2
+
+// time for the decode stage to wait for a frame in milliseconds
+#define KEV_VLC_PIPELINE_WAIT_MS    100
+
+// default downscale factor of the decode stage (1 for the capture resolution)
+#define KEV_VLC_DEFAULT_DECODE_SCALE    1
+
+/**
+ * @brief a class for decoding VLC frames off the GUI thread
+ *
+ * The pipeline connects three stages with bounded queues. The capture stage pushes
+ * stamped frames with slot_pushFrame() from its own thread into a lock-free ring,
+ * the decode stage runs the VLC decoder on this thread at the capture resolution
+ * (or an integer downscale of it), and the display stage on the GUI thread pops the
+ * decoded frames when sig_frameReady is emitted. Decoded bits and frame ends are
+ * batched in a bit stream, and sig_bitsDecoded is emitted once until the GUI takes
+ * the batch.
+ *
+ * While the decoder receives the data frames of a burst, only its ROI blocks are
+ * read, so sig_requestCrop asks the capture stage to crop the next frames to them.
+ * A cropped frame keeps its size, and only its region is copied, downscaled and
+ * queued for display over the pixels of an earlier frame.
+ */
+class KevDemoVLCPipeline : public QThread
+{
+    Q_OBJECT
+
+private:
+
+    // VLC decoder used only by the decode stage
+    KevDemoVLCDecoder *m_pVLCDecoder;
+
+    // queues between the stages
+    KevDemoFrameRing m_rDecodeRing;
+    KevDemoFrameQueue m_rDisplayQueue;
+
+    // captured frame and its downscaled frame of the decode stage
+    KevDemoFrame_t m_rCaptureFrame;
+    cv::Mat m_rDecodeFrame;
+
+    // crop of the captured frames requested by the decode stage
+    cv::Rect m_rCaptureCrop;
+
+    // decoded bits of the decode stage
+    KevDemoBitStream m_rFrameStream;
+
+    // settings and batched bits shared with the GUI thread
+    QMutex m_rMutex;
+
+    uint32_t m_nDecodeScale;
+    uint32_t m_nThreshold;
+    uint32_t m_nDataWidth;
+    bool m_bSettingsChanged;
+    bool m_bIsDecoding;
+
+    KevDemoBitStream m_rDecodedStream;
+
+    // pipeline flag, polled by the capture and decode threads
+    std::atomic<bool> m_bIsRunning;
+
+public:
+
+    explicit KevDemoVLCPipeline(KevDemoVLCDecoder *pVLCDecoder);
+    virtual ~KevDemoVLCPipeline();
+
+    /**
+     * @brief This function returns whether the pipeline is now opened or not.
+     * @return true if the pipeline is operating, otherwise false.
+     */
+    inline bool isOpened() { return m_bIsRunning; }
+
+    // open & close the pipeline
+    KevDemoError_t open();
+    void close();
+
+    // decoder settings applied between frames
+    void setThreshold(uint32_t nThreshold);
+    void setDataWidth(uint32_t nDataWidth);
+    void setDecodeScale(uint32_t nDecodeScale);
+    void setDecodingEnabled(bool bIsDecoding);
+
+    // display stage
+    bool popDisplayFrame(cv::Mat& rFrame);
+    bool takeDecodedBits(KevDemoBitStream& rDecodedStream);
+
+    // statistics
+    uint64_t getNumDroppedFrames();
+
+    // thread
+    void run();
+
+signals:
+
+    void sig_frameReady();
+
+    void sig_bitsDecoded();
+
+    void sig_requestCrop(QRect rCrop);
+
+public slots:
+
+    // capture stage
+    void slot_pushFrame(KevDemoFrame_t rFrame);
+
+private:
+
+    // apply the settings changed by the GUI thread
+    bool applySettings();
+
+    // request a crop of the captured frames to the data region of the decoder
+    void requestCrop(uint32_t nDecodeScale, bool bIsDecoding);
+};
+
+#endif // _KEV_DEMO_VLC_PIPELINE_H_
@@ -0,0 +1,293 @@
+#include "KevDemoVLCReplay.h"
+
+#include <QFile>
+#include <cstring>
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoVLCReplay class
+ * @param pDecoder a decoder to be fed with the replayed frames
+ */
+KevDemoVLCReplay::KevDemoVLCReplay(KevDemoVLCDecoder *pDecoder)
+{
+    m_pDecoder = pDecoder;
+    m_pSource = nullptr;
+
+    reset();
+}
+
+/**
+ * @brief This is a destructor of KevDemoVLCReplay class
+ */
+KevDemoVLCReplay::~KevDemoVLCReplay()
+{
+    close();
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function opens a frame source.
+ * @param rPath a directory of images, a video file, an image sequence pattern (e.g. frame_%04d.png),
+ *        or a camera (camera:N)
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCReplay::open(QString rPath)
+{
+    close();
+
+    m_pSource = KevDemoFrameSource::create(rPath);
+
+    KevDemoError_t error = m_pSource->open();
+
+    if(error != KEV_SUCCESS)
+    {
+        close();
+    }
+
+    return error;
+}
+
+/**
+ * @brief This function reads the next grayscale frame of the source.
+ * @param rFrame a read frame (CV_8UC1), which views the buffers of the source until the next read
+ * @return error information, KEV_ERROR_VLC_END_OF_SOURCE at the end of the source
+ */
+KevDemoError_t
+KevDemoVLCReplay::readFrame(cv::Mat& rFrame)
+{
+    if(m_pSource == nullptr)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    KevDemoError_t error = m_pSource->readFrame(m_rFrame);
+
+    if(error != KEV_SUCCESS)
+    {
+        return error;
+    }
+
+    rFrame = m_rFrame.image;
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function reads the next frame with its timestamp from the frame source.
+ * @param rFrame a read frame
+ * @return error information, KEV_ERROR_VLC_END_OF_SOURCE at the end of the source
+ */
+KevDemoError_t
+KevDemoVLCReplay::readFrame(KevDemoFrame_t& rFrame)
+{
+    if(m_pSource == nullptr)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    return m_pSource->readFrame(rFrame);
+}
+
+/**
+ * @brief This function closes the frame source.
+ */
+void
+KevDemoVLCReplay::close()
+{
+    if(m_pSource != nullptr)
+    {
+        m_pSource->close();
+
+        delete m_pSource;
+        m_pSource = nullptr;
+    }
+
+    m_rFrame.image.release();
+}
+
+/**
+ * @brief This function decodes a frame without a timestamp, which takes the next frame
+ *        slot of the decoder.
+ * @param rFrame a frame to decode
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCReplay::decodeFrame(cv::Mat& rFrame)
+{
+    return decodeFrame(rFrame, nullptr);
+}
+
+/**
+ * @brief This function decodes a timestamped frame on its frame slot.
+ * @param rFrame a frame to decode
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCReplay::decodeFrame(KevDemoFrame_t& rFrame)
+{
+    return decodeFrame(rFrame.image, &rFrame);
+}
+
+/**
+ * @brief This function decodes a frame and accounts its decode time.
+ * @param rImage the image of a frame to decode
+ * @param pFrame the timestamped frame of the image, or nullptr if not timestamped
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCReplay::decodeFrame(cv::Mat& rImage, KevDemoFrame_t *pFrame)
+{
+    if(m_pDecoder == NULL)
+    {
+        return KEV_ERROR_VLC_NOT_OPENED;
+    }
+
+    uint32_t state = std::min<uint32_t>(m_pDecoder->getState(), KEV_VLC_NUM_STATES - 1);
+    size_t numBits = m_rDecodedBits.size();
+
+    m_rTimer.start();
+    KevDemoError_t error = (pFrame != nullptr) ? m_pDecoder->decode(*pFrame, m_rDecodedBits) :
+                                                 m_pDecoder->decode(rImage, m_rDecodedBits);
+    int64_t elapsed = m_rTimer.nsecsElapsed();
+
+    m_rStats.decodeTime += elapsed;
+    m_rStats.stateTime[state] += elapsed;
+    m_rStats.stateFrames[state]++;
+
+    if(m_rStats.firstBitFrame < 0 && m_rDecodedBits.size() > numBits)
+    {
+        m_rStats.firstBitFrame = m_rStats.numFrames;
+        m_rStats.firstBitTime = m_rStats.decodeTime;
+    }
+
+    m_rStats.numFrames++;
+    m_rStats.numBits = m_rDecodedBits.size();
+
+    return error;
+}
+
+/**
+ * @brief This function feeds all the frames of the source to the decoder.
+ * @param nMaxFrames the maximum number of frames to be decoded (0 for all)
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCReplay::run(uint64_t nMaxFrames)
+{
+    while(nMaxFrames == 0 || m_rStats.numFrames < nMaxFrames)
+    {
+        KevDemoError_t error = readFrame(m_rFrame);
+
+        if(error == KEV_ERROR_VLC_END_OF_SOURCE)
+        {
+            break;
+        }
+        else if(error != KEV_SUCCESS)
+        {
+            return error;
+        }
+
+        error = decodeFrame(m_rFrame);
+
+        if(error != KEV_SUCCESS)
+        {
+            return error;
+        }
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function clears the decoded bits and the statistics.
+ */
+void
+KevDemoVLCReplay::reset()
+{
+    m_rDecodedBits.clear();
+
+    memset(&m_rStats, 0, sizeof(m_rStats));
+    m_rStats.firstBitFrame = -1;
+    m_rStats.firstBitTime = -1;
+}
+
+/**
+ * @brief This function loads an expected bitstream from a text file.
+ *        Characters other than '0' and '1' are ignored, and '#' starts a comment line.
+ * @param rPath a bitstream file
+ * @param rBits loaded bits
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCReplay::loadBits(QString rPath, std::vector<int>& rBits)
+{
+    QFile file(rPath);
+
+    if(file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+    {
+        return KEV_ERROR_VLC_SOURCE_NOT_OPENED;
+    }
+
+    rBits.clear();
+
+    while(file.atEnd() == false)
+    {
+        QByteArray line = file.readLine().trimmed();
+
+        if(line.startsWith('#') == true)
+        {
+            continue;
+        }
+
+        for(char ch : line)
+        {
+            if(ch == '0' || ch == '1')
+            {
+                rBits.push_back(ch - '0');
+            }
+        }
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function compares a decoded bitstream with the expected one bit by bit.
+ * @param rExpected expected bits
+ * @param rDecoded decoded bits
+ * @return the number of compared, erroneous, missing and extra bits
+ */
+KevDemoBitDiff_t
+KevDemoVLCReplay::compareBits(const std::vector<int>& rExpected, const std::vector<int>& rDecoded)
+{
+    KevDemoBitDiff_t diff = {0, 0, 0, 0};
+
+    diff.numCompared = std::min(rExpected.size(), rDecoded.size());
+
+    for(uint64_t i = 0; i < diff.numCompared; i++)
+    {
+        if(rExpected[i] != rDecoded[i])
+        {
+            diff.numErrors++;
+        }
+    }
+
+    if(rExpected.size() > rDecoded.size())
+    {
+        diff.numMissing = rExpected.size() - rDecoded.size();
+    }
+    else
+    {
+        diff.numExtra = rDecoded.size() - rExpected.size();
+    }
+
+    return diff;
+}
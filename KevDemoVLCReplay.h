@@ -0,0 +1,101 @@
+#ifndef _KEV_DEMO_VLC_REPLAY_H_
+#define _KEV_DEMO_VLC_REPLAY_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoVLCDecoder.h"
+#include "KevDemoFrameSource.h"
+
+#include <QElapsedTimer>
+
+// number of VLC states accounted by the replay
+#define KEV_VLC_NUM_STATES  3
+
+/**
+ * @brief statistics of a replay
+ */
+typedef struct KevDemoReplayStats {
+    // number of decoded frames and bits
+    uint64_t numFrames;
+    uint64_t numBits;
+
+    // time spent in decode() in nanoseconds
+    int64_t decodeTime;
+
+    // frames and decode time per VLC state at the entry of decode()
+    uint64_t stateFrames[KEV_VLC_NUM_STATES];
+    int64_t stateTime[KEV_VLC_NUM_STATES];
+
+    // frame index and accumulated decode time of the first decoded bit (-1 if none)
+    int64_t firstBitFrame;
+    int64_t firstBitTime;
+} KevDemoReplayStats_t;
+
+/**
+ * @brief result of comparing a decoded bitstream with the expected one
+ */
+typedef struct KevDemoBitDiff {
+    uint64_t numCompared;
+    uint64_t numErrors;
+    uint64_t numMissing;
+    uint64_t numExtra;
+} KevDemoBitDiff_t;
+
+/**
+ * @brief a class for replaying recorded frames through a VLC decoder
+ *
+ * Frames are read from a frame source, e.g. a video file, an image sequence pattern,
+ * a directory of images or a camera, and fed to the decoder as fast as possible with
+ * their timestamps, so that the frames missed by the source are accounted by the
+ * symbol timing of the decoder. The time of each decode() call is accounted to the
+ * VLC state at its entry, and all the decoded bits are kept so that they can be
+ * compared with an expected bitstream.
+ */
+class KevDemoVLCReplay
+{
+private:
+
+    // decoder under test
+    KevDemoVLCDecoder *m_pDecoder;
+
+    // frame source and its last frame
+    KevDemoFrameSource *m_pSource;
+    KevDemoFrame_t m_rFrame;
+
+    // all the decoded bits
+    std::vector<int> m_rDecodedBits;
+
+    // replay statistics
+    KevDemoReplayStats_t m_rStats;
+
+    QElapsedTimer m_rTimer;
+
+    KevDemoError_t decodeFrame(cv::Mat& rImage, KevDemoFrame_t *pFrame);
+
+public:
+
+    explicit KevDemoVLCReplay(KevDemoVLCDecoder *pDecoder);
+    virtual ~KevDemoVLCReplay();
+
+    // frame source
+    KevDemoError_t open(QString rPath);
+    KevDemoError_t readFrame(cv::Mat& rFrame);
+    KevDemoError_t readFrame(KevDemoFrame_t& rFrame);
+    void close();
+
+    // replay procedures
+    KevDemoError_t decodeFrame(cv::Mat& rFrame);
+    KevDemoError_t decodeFrame(KevDemoFrame_t& rFrame);
+    KevDemoError_t run(uint64_t nMaxFrames = 0);
+    void reset();
+
+    // accessor
+    inline double getSourceFPS()                            { return (m_pSource != nullptr) ? m_pSource->getFPS() : 0; }
+    inline const KevDemoReplayStats_t& getStats()           { return m_rStats;       }
+    inline const std::vector<int>& getDecodedBits()         { return m_rDecodedBits; }
+
+    // expected bitstream
+    static KevDemoError_t loadBits(QString rPath, std::vector<int>& rBits);
+    static KevDemoBitDiff_t compareBits(const std::vector<int>& rExpected, const std::vector<int>& rDecoded);
+};
+
+#endif // _KEV_DEMO_VLC_REPLAY_H_
@@ -0,0 +1,272 @@
+#include "KevDemoVLCSynth.h"
+
+#include <algorithm>
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoVLCSynth class
+ */
+KevDemoVLCSynth::KevDemoVLCSynth()
+{
+    m_rConfig = getDefaultConfig(cv::Size(640, 480), 16);
+    m_nFrameIndex = 0;
+    m_nNumFrames = 0;
+}
+
+/**
+ * @brief This is a destructor of KevDemoVLCSynth class
+ */
+KevDemoVLCSynth::~KevDemoVLCSynth()
+{
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function returns a configuration of an ideal LED array.
+ * @param rFrameSize frame size
+ * @param nDataWidth the number of LEDs including the clock LED
+ * @return a configuration without impairments
+ */
+KevDemoSynthConfig_t
+KevDemoVLCSynth::getDefaultConfig(cv::Size rFrameSize, uint32_t nDataWidth)
+{
+    KevDemoSynthConfig_t config;
+
+    config.frameSize = rFrameSize;
+    config.dataWidth = nDataWidth;
+    config.clockIndex = 0;
+    config.clockless = false;
+    config.manchester = false;
+    config.ledRadius = KEV_SYNTH_LED_RADIUS;
+    config.ledSpacing = KEV_SYNTH_LED_SPACING;
+    config.backgroundLevel = KEV_SYNTH_LEVEL_BACKGROUND;
+    config.ledOffLevel = KEV_SYNTH_LEVEL_LED_OFF;
+    config.ledOnLevel = KEV_SYNTH_LEVEL_LED_ON;
+    config.numIdleFrames = KEV_SYNTH_NUM_IDLE_FRAMES;
+    config.numSyncFrames = KEV_VLC_NUM_SYNC_FRAMES;
+    config.numDataFrames = KEV_VLC_NUM_DATA_FRAMES;
+    config.noiseSigma = 0;
+    config.blurSigma = 0;
+    config.flickerAmplitude = 0;
+    config.jitterAmplitude = 0;
+    config.swayAmplitude = 0;
+    config.seed = 0x4B4556;
+
+    return config;
+}
+
+/**
+ * @brief This function lays out the LEDs of the given configuration.
+ * @param rConfig a configuration of the LED array
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCSynth::configure(const KevDemoSynthConfig_t& rConfig)
+{
+    if(rConfig.dataWidth < 2 || rConfig.clockIndex >= rConfig.dataWidth ||
+       rConfig.ledRadius <= 0 || rConfig.ledSpacing <= 2 * rConfig.ledRadius ||
+       rConfig.numDataFrames < 2 || (rConfig.clockless == true && rConfig.manchester == true))
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    int cols = std::min<int>(rConfig.dataWidth, KEV_SYNTH_LED_MAX_COLUMNS);
+    int rows = (rConfig.dataWidth + cols - 1) / cols;
+
+    // the grid with its jitter and sway must fit in the frame
+    int margin = rConfig.ledRadius + (int)ceil(rConfig.jitterAmplitude + rConfig.swayAmplitude) + 2;
+    int gridWidth  = (cols - 1) * rConfig.ledSpacing + 2 * margin;
+    int gridHeight = (rows - 1) * rConfig.ledSpacing + 2 * margin;
+
+    if(gridWidth > rConfig.frameSize.width || gridHeight > rConfig.frameSize.height)
+    {
+        return KEV_ERROR_INVALID_ARGUMENTS;
+    }
+
+    m_rConfig = rConfig;
+
+    float originX = (rConfig.frameSize.width  - (cols - 1) * rConfig.ledSpacing) / 2.0f;
+    float originY = (rConfig.frameSize.height - (rows - 1) * rConfig.ledSpacing) / 2.0f;
+
+    m_rLEDCenters.clear();
+
+    for(uint32_t i = 0; i < rConfig.dataWidth; i++)
+    {
+        m_rLEDCenters.push_back(cv::Point2f(originX + (i % cols) * rConfig.ledSpacing,
+                                            originY + (i / cols) * rConfig.ledSpacing));
+    }
+
+    m_rLEDStates.assign(rConfig.dataWidth, 0);
+
+    return setBitstream(std::vector<int>());
+}
+
+/**
+ * @brief This function sets the bitstream to be transmitted, and rewinds the frames.
+ *        The bitstream is padded with zeros to whole symbols.
+ * @param rBits bits to be transmitted
+ * @return error information
+ */
+KevDemoError_t
+KevDemoVLCSynth::setBitstream(const std::vector<int>& rBits)
+{
+    uint32_t bitsPerSymbol = getBitsPerSymbol();
+
+    m_rBits = rBits;
+    m_rBits.resize((m_rBits.size() + bitsPerSymbol - 1) / bitsPerSymbol * bitsPerSymbol, 0);
+
+    uint64_t numSymbols = m_rBits.size() / bitsPerSymbol;
+    uint64_t numBursts = (numSymbols + getSymbolsPerBurst() - 1) / getSymbolsPerBurst();
+
+    // trailing idle frames let the decoder settle after the last burst
+    m_nNumFrames = numBursts * getFramesPerBurst() + m_rConfig.numIdleFrames;
+
+    rewind();
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function renders the next frame.
+ * @param rFrame a rendered frame (CV_8UC1)
+ * @return error information, KEV_ERROR_VLC_END_OF_SOURCE after the last frame
+ */
+KevDemoError_t
+KevDemoVLCSynth::renderFrame(cv::Mat& rFrame)
+{
+    if(m_nFrameIndex >= m_nNumFrames)
+    {
+        return KEV_ERROR_VLC_END_OF_SOURCE;
+    }
+
+    scheduleFrame(m_nFrameIndex++);
+
+    rFrame.create(m_rConfig.frameSize, CV_8UC1);
+    rFrame.setTo(cv::Scalar(m_rConfig.backgroundLevel));
+
+    // shake the whole array by a sub-pixel offset
+    float dx = 0;
+    float dy = 0;
+
+    if(m_rConfig.jitterAmplitude > 0)
+    {
+        dx = m_rRNG.uniform(-m_rConfig.jitterAmplitude, m_rConfig.jitterAmplitude);
+        dy = m_rRNG.uniform(-m_rConfig.jitterAmplitude, m_rConfig.jitterAmplitude);
+    }
+
+    // sway mostly vertically over several bursts
+    if(m_rConfig.swayAmplitude > 0)
+    {
+        double phase = 2 * CV_PI * m_nFrameIndex / KEV_SYNTH_SWAY_PERIOD;
+
+        dx += m_rConfig.swayAmplitude / 2 * (float)sin(phase);
+        dy += m_rConfig.swayAmplitude * (float)sin(phase);
+    }
+
+    const int scale = 1 << KEV_SYNTH_SUBPIXEL_SHIFT;
+
+    for(uint32_t i = 0; i < m_rLEDCenters.size(); i++)
+    {
+        cv::Point center(cvRound((m_rLEDCenters[i].x + dx) * scale),
+                         cvRound((m_rLEDCenters[i].y + dy) * scale));
+        int level = m_rLEDStates[i] ? m_rConfig.ledOnLevel : m_rConfig.ledOffLevel;
+
+        cv::circle(rFrame, center, m_rConfig.ledRadius * scale, cv::Scalar(level),
+                   cv::FILLED, cv::LINE_AA, KEV_SYNTH_SUBPIXEL_SHIFT);
+    }
+
+    if(m_rConfig.blurSigma > 0)
+    {
+        cv::GaussianBlur(rFrame, rFrame, cv::Size(0, 0), m_rConfig.blurSigma);
+    }
+
+    // exposure flicker scales the whole frame
+    if(m_rConfig.flickerAmplitude > 0)
+    {
+        double gain = 1.0 + m_rRNG.uniform(-m_rConfig.flickerAmplitude, m_rConfig.flickerAmplitude);
+        rFrame.convertTo(rFrame, -1, gain);
+    }
+
+    if(m_rConfig.noiseSigma > 0)
+    {
+        m_rNoise.create(m_rConfig.frameSize, CV_16SC1);
+        m_rRNG.fill(m_rNoise, cv::RNG::NORMAL, 0, m_rConfig.noiseSigma);
+        cv::add(rFrame, m_rNoise, rFrame, cv::noArray(), CV_8U);
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function restarts the frames from the first one with the same impairments.
+ */
+void
+KevDemoVLCSynth::rewind()
+{
+    m_nFrameIndex = 0;
+    m_rRNG = cv::RNG(m_rConfig.seed);
+}
+
+/**
+ * @brief This function determines the LED states of a frame of the schedule.
+ * @param nFrameIndex frame index
+ */
+void
+KevDemoVLCSynth::scheduleFrame(uint64_t nFrameIndex)
+{
+    std::fill(m_rLEDStates.begin(), m_rLEDStates.end(), 0);
+
+    uint64_t burst = nFrameIndex / getFramesPerBurst();
+    uint32_t offset = nFrameIndex % getFramesPerBurst();
+
+    // idle frames
+    if(offset < m_rConfig.numIdleFrames)
+    {
+        return;
+    }
+
+    offset -= m_rConfig.numIdleFrames;
+
+    // a sync start frame followed by the sync frames, toggling all the LEDs
+    if(offset < 1 + m_rConfig.numSyncFrames)
+    {
+        std::fill(m_rLEDStates.begin(), m_rLEDStates.end(), (offset % 2 == 0) ? 1 : 0);
+        return;
+    }
+
+    offset -= 1 + m_rConfig.numSyncFrames;
+
+    // data frames; a symbol is held for two frames and the clock LED rises on the first one
+    uint32_t bitsPerSymbol = getBitsPerSymbol();
+    uint64_t symbol = burst * getSymbolsPerBurst() + offset / 2;
+
+    if(offset / 2 >= getSymbolsPerBurst() || symbol * bitsPerSymbol >= m_rBits.size())
+    {
+        return;
+    }
+
+    const int *bits = &m_rBits[symbol * bitsPerSymbol];
+
+    for(uint32_t i = 0, j = 0; i < m_rConfig.dataWidth; i++)
+    {
+        if(m_rConfig.clockless == false && i == m_rConfig.clockIndex)
+        {
+            m_rLEDStates[i] = (offset % 2 == 0) ? 1 : 0;
+        }
+        else
+        {
+            m_rLEDStates[i] = (uint8_t)bits[j++];
+
+            if(m_rConfig.manchester == true && offset % 2 == 1)
+            {
+                m_rLEDStates[i] ^= 1;
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#ifndef _KEV_DEMO_VLC_SYNTH_H_
+#define _KEV_DEMO_VLC_SYNTH_H_
+
+#include "KevDemoConfig.h"
+#include "KevDemoVLCDecoder.h"
+
+// synthetic LED defaults
+#define KEV_SYNTH_LED_RADIUS        10
+#define KEV_SYNTH_LED_SPACING       48
+#define KEV_SYNTH_LED_MAX_COLUMNS   8
+#define KEV_SYNTH_LEVEL_BACKGROUND  20
+#define KEV_SYNTH_LEVEL_LED_OFF     40
+#define KEV_SYNTH_LEVEL_LED_ON      230
+
+// number of idle frames before each burst
+#define KEV_SYNTH_NUM_IDLE_FRAMES   2
+
+// fixed-point bits of sub-pixel LED centers
+#define KEV_SYNTH_SUBPIXEL_SHIFT    4
+
+// period of the sway of the whole array in frames
+#define KEV_SYNTH_SWAY_PERIOD       90
+
+/**
+ * @brief configuration of a synthetic LED array
+ */
+typedef struct KevDemoSynthConfig {
+    // frame size
+    cv::Size frameSize;
+
+    // number of LEDs including the clock LED, and the index of the clock LED
+    uint32_t dataWidth;
+    uint32_t clockIndex;
+
+    // whether all the LEDs carry bits without a clock LED
+    bool clockless;
+
+    // whether the data LEDs invert their bits while the clock LED is off
+    bool manchester;
+
+    // LED radius and the distance of neighbouring LED centers in pixels
+    int ledRadius;
+    int ledSpacing;
+
+    // gray levels of the background and of the switched-off/on LEDs
+    int backgroundLevel;
+    int ledOffLevel;
+    int ledOnLevel;
+
+    // frames of a burst
+    uint32_t numIdleFrames;
+    uint32_t numSyncFrames;
+    uint32_t numDataFrames;
+
+    // impairments: sigma of additive gaussian noise, sigma of gaussian blur,
+    // relative amplitude of exposure flicker, amplitude of sub-pixel jitter in pixels,
+    // and amplitude of a slow sway in pixels, e.g. of a vehicle settling on its suspension
+    float noiseSigma;
+    float blurSigma;
+    float flickerAmplitude;
+    float jitterAmplitude;
+    float swayAmplitude;
+
+    // seed of the impairments
+    uint64_t seed;
+} KevDemoSynthConfig_t;
+
+/**
+ * @brief a class for rendering a synthetic VLC LED array into grayscale frames
+ *
+ * A bitstream is sent in bursts, each of which consists of idle frames with all the
+ * LEDs off, a sync preamble toggling all the LEDs in every frame, and data frames.
+ * A data symbol is held for two frames, with the clock LED on in the first frame and
+ * off in the second one, and carries (dataWidth - 1) bits on the other LEDs in reading
+ * order. In clockless mode, a symbol carries dataWidth bits on all the LEDs. In
+ * Manchester mode, the data LEDs show the inverted bits in the second frame.
+ * The LEDs are laid out in a grid centered in the frame.
+ */
+class KevDemoVLCSynth
+{
+private:
+
+    KevDemoSynthConfig_t m_rConfig;
+
+    // LED centers in reading order
+    std::vector<cv::Point2f> m_rLEDCenters;
+
+    // transmitted bits padded to whole symbols
+    std::vector<int> m_rBits;
+
+    // frame schedule
+    uint64_t m_nFrameIndex;
+    uint64_t m_nNumFrames;
+
+    // LED states of the current frame
+    std::vector<uint8_t> m_rLEDStates;
+
+    // noise buffer
+    cv::Mat m_rNoise;
+
+    cv::RNG m_rRNG;
+
+public:
+
+    explicit KevDemoVLCSynth();
+    virtual ~KevDemoVLCSynth();
+
+    static KevDemoSynthConfig_t getDefaultConfig(cv::Size rFrameSize, uint32_t nDataWidth);
+
+    // synthesis procedures
+    KevDemoError_t configure(const KevDemoSynthConfig_t& rConfig);
+    KevDemoError_t setBitstream(const std::vector<int>& rBits);
+    KevDemoError_t renderFrame(cv::Mat& rFrame);
+    void rewind();
+
+    // accessor
+    inline const KevDemoSynthConfig_t& getConfig()      { return m_rConfig;     }
+    inline const std::vector<int>& getExpectedBits()    { return m_rBits;       }
+    inline uint64_t getNumFrames()                      { return m_nNumFrames;  }
+    inline uint64_t getFrameIndex()                     { return m_nFrameIndex; }
+
+    /**
+     * @brief This function returns the number of bits of a data symbol.
+     * @return the number of LEDs, excluding the clock LED unless clockless
+     */
+    inline uint32_t getBitsPerSymbol()
+    {
+        return (m_rConfig.clockless == true) ? m_rConfig.dataWidth : m_rConfig.dataWidth - 1;
+    }
+
+    /**
+     * @brief This function returns the number of data symbols of a burst.
+     * @return the number of data symbols
+     */
+    inline uint32_t getSymbolsPerBurst()
+    {
+        return m_rConfig.numDataFrames / 2;
+    }
+
+    /**
+     * @brief This function returns the number of frames of a burst.
+     * @return the number of frames
+     */
+    inline uint32_t getFramesPerBurst()
+    {
+        return m_rConfig.numIdleFrames + 1 + m_rConfig.numSyncFrames + m_rConfig.numDataFrames;
+    }
+
+private:
+
+    // determine the LED states of a frame
+    void scheduleFrame(uint64_t nFrameIndex);
+};
+
+#endif // _KEV_DEMO_VLC_SYNTH_H_
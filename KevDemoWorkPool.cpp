@@ -0,0 +1,256 @@
+#include "KevDemoWorkPool.h"
+
+#include <algorithm>
+
+// the pool and the index of the worker running on this thread, if any
+static thread_local KevDemoWorkPool *s_pCurrentPool = nullptr;
+static thread_local uint32_t s_nCurrentWorker = 0;
+
+//////////////////////////////////////////////////
+// Constructor & Destructor Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This is a constructor of KevDemoWorkPool class
+ * @param nNumWorkers the number of worker threads (at least one)
+ */
+KevDemoWorkPool::KevDemoWorkPool(uint32_t nNumWorkers)
+{
+    nNumWorkers = std::max<uint32_t>(nNumWorkers, 1);
+
+    m_rQueues.resize(nNumWorkers);
+    m_rStats.assign(nNumWorkers, KevDemoWorkStats_t());
+
+    for(uint32_t i = 0; i < nNumWorkers; i++)
+    {
+        m_rQueueMutexes.push_back(new QMutex());
+        m_rWorkers.push_back(new Worker(this, i));
+    }
+
+    m_nNumQueued = 0;
+    m_nNextQueue = 0;
+    m_bIsRunning = false;
+}
+
+/**
+ * @brief This is a destructor of KevDemoWorkPool class
+ */
+KevDemoWorkPool::~KevDemoWorkPool()
+{
+    close();
+
+    for(uint32_t i = 0; i < m_rWorkers.size(); i++)
+    {
+        delete m_rWorkers[i];
+        delete m_rQueueMutexes[i];
+    }
+}
+
+/**
+ * @brief This is a constructor of KevDemoWorkPool::Worker class
+ * @param pPool the pool of the worker
+ * @param nIndex index of the worker
+ */
+KevDemoWorkPool::Worker::Worker(KevDemoWorkPool *pPool, uint32_t nIndex)
+{
+    m_pPool = pPool;
+    m_nIndex = nIndex;
+}
+
+//////////////////////////////////////////////////
+// Member Function Definition
+//////////////////////////////////////////////////
+
+/**
+ * @brief This function starts the worker threads.
+ * @return error information
+ */
+KevDemoError_t
+KevDemoWorkPool::open()
+{
+    if(m_bIsRunning == true)
+    {
+        return KEV_SUCCESS;
+    }
+
+    m_bIsRunning = true;
+
+    for(Worker *worker : m_rWorkers)
+    {
+        worker->start();
+    }
+
+    return KEV_SUCCESS;
+}
+
+/**
+ * @brief This function stops the worker threads after their running items, and drops
+ *        the queued items.
+ */
+void
+KevDemoWorkPool::close()
+{
+    {
+        QMutexLocker locker(&m_rMutex);
+
+        m_bIsRunning = false;
+        m_rWorkReady.wakeAll();
+    }
+
+    for(Worker *worker : m_rWorkers)
+    {
+        worker->wait();
+    }
+
+    for(uint32_t i = 0; i < m_rQueues.size(); i++)
+    {
+        QMutexLocker locker(m_rQueueMutexes[i]);
+        m_rQueues[i].clear();
+    }
+
+    m_nNumQueued = 0;
+}
+
+/**
+ * @brief This function queues a work item. An item submitted by a worker of this pool
+ *        goes to the back of its own queue, and otherwise to the queues in turn.
+ * @param pItem a work item, which must not be queued already
+ * @return true if the item is queued, or false if the pool is closed
+ */
+bool
+KevDemoWorkPool::submit(KevDemoWorkItem *pItem)
+{
+    if(pItem == nullptr || m_bIsRunning == false)
+    {
+        return false;
+    }
+
+    uint32_t index;
+
+    if(s_pCurrentPool == this)
+    {
+        index = s_nCurrentWorker;
+    }
+    else
+    {
+        QMutexLocker locker(&m_rMutex);
+
+        index = m_nNextQueue;
+        m_nNextQueue = (m_nNextQueue + 1) % m_rQueues.size();
+    }
+
+    {
+        QMutexLocker locker(m_rQueueMutexes[index]);
+        m_rQueues[index].push_back(pItem);
+    }
+
+    QMutexLocker locker(&m_rMutex);
+
+    m_nNumQueued++;
+    m_rWorkReady.wakeOne();
+
+    return true;
+}
+
+/**
+ * @brief This function returns the statistics summed over the workers.
+ * @return statistics of the pool
+ */
+KevDemoWorkStats_t
+KevDemoWorkPool::getStats()
+{
+    QMutexLocker locker(&m_rMutex);
+
+    KevDemoWorkStats_t stats = {0, 0};
+
+    for(const KevDemoWorkStats_t &workerStats : m_rStats)
+    {
+        stats.numRuns += workerStats.numRuns;
+        stats.numSteals += workerStats.numSteals;
+    }
+
+    return stats;
+}
+
+/**
+ * @brief This function takes the oldest item of the given worker, or steals the oldest
+ *        item of the other workers in turn from the next one.
+ * @param nIndex index of the worker
+ * @return a work item, or nullptr if all the queues are empty
+ */
+KevDemoWorkItem *
+KevDemoWorkPool::takeItem(uint32_t nIndex)
+{
+    KevDemoWorkItem *item = nullptr;
+    uint32_t numQueues = (uint32_t)m_rQueues.size();
+    uint32_t victim = nIndex;
+
+    for(uint32_t i = 0; i < numQueues && item == nullptr; i++)
+    {
+        victim = (nIndex + i) % numQueues;
+
+        QMutexLocker locker(m_rQueueMutexes[victim]);
+
+        if(m_rQueues[victim].empty() == false)
+        {
+            item = m_rQueues[victim].front();
+            m_rQueues[victim].pop_front();
+        }
+    }
+
+    if(item != nullptr)
+    {
+        QMutexLocker locker(&m_rMutex);
+
+        m_nNumQueued--;
+        m_rStats[nIndex].numRuns++;
+
+        if(victim != nIndex)
+        {
+            m_rStats[nIndex].numSteals++;
+        }
+    }
+
+    return item;
+}
+
+/**
+ * @brief This function runs the items of a worker, and sleeps while there is no item
+ *        in any queue.
+ * @param nIndex index of the worker
+ */
+void
+KevDemoWorkPool::runWorker(uint32_t nIndex)
+{
+    s_pCurrentPool = this;
+    s_nCurrentWorker = nIndex;
+
+    while(m_bIsRunning == true)
+    {
+        KevDemoWorkItem *item = takeItem(nIndex);
+
+        if(item != nullptr)
+        {
+            item->runWork();
+            continue;
+        }
+
+        QMutexLocker locker(&m_rMutex);
+
+        if(m_nNumQueued <= 0 && m_bIsRunning == true)
+        {
+            m_rWorkReady.wait(&m_rMutex, KEV_WORK_POOL_WAIT_MS);
+        }
+    }
+
+    s_pCurrentPool = nullptr;
+}
+
+/**
+ * @brief This function runs the worker thread.
+ */
+void
+KevDemoWorkPool::Worker::run()
+{
+    m_pPool->runWorker(m_nIndex);
+}
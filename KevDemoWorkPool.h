@@ -0,0 +1,113 @@
+#ifndef _KEV_DEMO_WORK_POOL_H_
+#define _KEV_DEMO_WORK_POOL_H_
+
+#include "KevDemoConfig.h"
+
+#include <atomic>
+#include <deque>
+#include <QMutex>
+#include <QWaitCondition>
+
+// time for an idle worker to wait for work in milliseconds
+#define KEV_WORK_POOL_WAIT_MS   100
+
+/**
+ * @brief an interface of a unit of work run by KevDemoWorkPool
+ */
+class KevDemoWorkItem
+{
+public:
+
+    virtual ~KevDemoWorkItem() {}
+
+    // run a slice of work on a worker thread
+    virtual void runWork() = 0;
+};
+
+/**
+ * @brief statistics of the workers of a pool
+ */
+typedef struct KevDemoWorkStats {
+    uint64_t numRuns;
+    uint64_t numSteals;
+} KevDemoWorkStats_t;
+
+/**
+ * @brief a class for running work items on a fixed number of worker threads
+ *
+ * Each worker has its own queue of work items. An item submitted by a worker, e.g.
+ * an item rescheduling itself, goes to the back of the queue of that worker, and an
+ * item submitted by any other thread goes to the queues in turn. A worker runs the
+ * items of its queue in order, and an idle worker steals the oldest item of the
+ * other queues, so the items are spread over all the workers and each one waits
+ * for the items queued before it only. An item is never queued twice by its owner,
+ * so it runs on a single worker at a time.
+ */
+class KevDemoWorkPool
+{
+private:
+
+    /**
+     * @brief a worker thread of the pool
+     */
+    class Worker : public QThread
+    {
+    public:
+
+        explicit Worker(KevDemoWorkPool *pPool, uint32_t nIndex);
+
+        // thread
+        void run();
+
+    private:
+
+        KevDemoWorkPool *m_pPool;
+        uint32_t m_nIndex;
+    };
+
+    // workers and their queues of work items
+    std::vector<Worker *> m_rWorkers;
+    std::vector<std::deque<KevDemoWorkItem *> > m_rQueues;
+    std::vector<QMutex *> m_rQueueMutexes;
+    std::vector<KevDemoWorkStats_t> m_rStats;
+
+    // the number of queued items, which idle workers wait on; it may be -1 for a moment
+    // while an item is taken before its submission is counted
+    QMutex m_rMutex;
+    QWaitCondition m_rWorkReady;
+    int32_t m_nNumQueued;
+
+    // queue of the next item submitted by a non-worker thread
+    uint32_t m_nNextQueue;
+
+    // pool flag, read by the workers and the submitting threads without a lock
+    std::atomic<bool> m_bIsRunning;
+
+public:
+
+    explicit KevDemoWorkPool(uint32_t nNumWorkers);
+    virtual ~KevDemoWorkPool();
+
+    // open & close the pool
+    KevDemoError_t open();
+    void close();
+
+    // queue a work item
+    bool submit(KevDemoWorkItem *pItem);
+
+    // accessor
+    inline uint32_t getNumWorkers()     { return (uint32_t)m_rWorkers.size(); }
+    inline bool isRunning()             { return m_bIsRunning;                }
+
+    KevDemoWorkStats_t getStats();
+
+private:
+
+    // take an item of the given worker, or steal one from the other workers
+    KevDemoWorkItem *takeItem(uint32_t nIndex);
+
+    // run the items of a worker until the pool is closed
+    void runWorker(uint32_t nIndex);
+};
+
+#endif // _KEV_DEMO_WORK_POOL_H_